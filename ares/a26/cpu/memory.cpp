@@ -1,6 +1,6 @@
 inline auto CPU::readBus(n16 address) -> n8 {
   address &= 0x1fff;
-  if(auto result = platform->cheat(address)) return *result;
+  if(auto result = cheats.find(address)) return *result;
 
   n8 data = cartridge.read(address);
 
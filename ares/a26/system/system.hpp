@@ -32,7 +32,7 @@ struct System {
   auto power(bool reset) -> void;
 
   //serialization.cpp
-  auto serialize(bool synchronize) -> serializer;
+  auto serialize(bool synchronize, serializer = {}) -> serializer;
   auto unserialize(serializer&) -> bool;
 
 private:
@@ -7,7 +7,9 @@
 namespace ares {
 
 Platform* platform = nullptr;
+Cheats cheats;
 bool _runAhead = false;
+u64 _contextSwitches = 0;
 
 const string Name       = "ares";
 const string Version    = "136";
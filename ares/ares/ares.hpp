@@ -68,6 +68,11 @@ namespace ares {
   extern bool _runAhead;
   inline auto runAhead() -> bool { return _runAhead; }
   inline auto setRunAhead(bool runAhead) -> void { _runAhead = runAhead; }
+
+  //the number of thread context switches performed during the previous frame.
+  //every switch has a cost, so this is useful for finding overly fine-grained synchronization.
+  extern u64 _contextSwitches;
+  inline auto contextSwitches() -> u64 { return _contextSwitches; }
 }
 
 #include <ares/types.hpp>
@@ -75,6 +80,7 @@ namespace ares {
 #include <ares/debug/debug.hpp>
 #include <ares/node/node.hpp>
 #include <ares/platform.hpp>
+#include <ares/cheats.hpp>
 #include <ares/memory/fixed-allocator.hpp>
 #include <ares/memory/readable.hpp>
 #include <ares/memory/writable.hpp>
@@ -0,0 +1,69 @@
+#pragma once
+
+namespace ares {
+
+//the enabled cheat codes, compiled by the frontend into a form that the buses can check on every read.
+//a bitmap marks each 256-byte page holding at least one code; only reads from those pages search the hash table.
+struct Cheats {
+  explicit operator bool() const { return _size; }
+
+  auto reset() -> void {
+    for(auto& page : _pages) page = 0;
+    _entries.reset();
+    _size = 0;
+    _mask = 0;
+  }
+
+  //when more than one code patches the same address, the first one appended is used.
+  auto append(u32 address, u32 data) -> void {
+    if(find(address)) return;
+    if(_size * 2 >= _entries.size()) {
+      auto entries = std::move(_entries);
+      _entries.resize(max(16u, (u32)entries.size() * 2));
+      _mask = _entries.size() - 1;
+      _size = 0;
+      for(auto& entry : entries) {
+        if(entry.valid) insert(entry.address, entry.data);
+      }
+    }
+    insert(address, data);
+  }
+
+  alwaysinline auto find(u32 address) const -> maybe<u32> {
+    if(likely(!_size)) return nothing;
+    if(!(_pages[address >> 14 & 1023] >> (address >> 8 & 63) & 1)) return nothing;
+    for(u32 index = hash(address); _entries[index].valid; index = index + 1 & _mask) {
+      if(_entries[index].address == address) return _entries[index].data;
+    }
+    return nothing;
+  }
+
+private:
+  struct Entry {
+    u32  address = 0;
+    u32  data = 0;
+    bool valid = false;
+  };
+
+  auto hash(u32 address) const -> u32 {
+    address *= 0x9e3779b1;
+    return (address ^ address >> 16) & _mask;
+  }
+
+  auto insert(u32 address, u32 data) -> void {
+    u32 index = hash(address);
+    while(_entries[index].valid) index = index + 1 & _mask;
+    _entries[index] = {address, data, true};
+    _pages[address >> 14 & 1023] |= 1ull << (address >> 8 & 63);
+    _size++;
+  }
+
+  u64 _pages[1024] = {};  //one bit per 256-byte page (addresses are folded into 16M)
+  vector<Entry> _entries;
+  u32 _size = 0;
+  u32 _mask = 0;
+};
+
+extern Cheats cheats;
+
+}
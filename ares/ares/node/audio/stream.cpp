@@ -111,18 +111,34 @@ auto Stream::read(f64 samples[]) -> u32 {
 }
 
 auto Stream::write(const f64 samples[]) -> void {
-  for(u32 c : range(_channels.size())) {
-    f64 sample = samples[c] + 1e-25;  //constant offset used to suppress denormals
-    for(auto& filter : _channels[c].filters) {
-      switch(filter.mode) {
-      case Filter::Mode::OnePole: sample = filter.onePole.process(sample); break;
-      case Filter::Mode::Biquad: sample = filter.biquad.process(sample); break;
+  write(samples, 1);
+}
+
+//samples are interleaved: frames * channels() values.
+//each channel is run through its filter chain one filter at a time over blocks of frames,
+//and the frontend is alerted only once for the entire write.
+auto Stream::write(const f64 samples[], u32 frames) -> void {
+  u32 channels = _channels.size();
+  f64 block[Block];
+  for(u32 offset = 0; offset < frames; offset += Block) {
+    u32 length = min(Block, frames - offset);
+    for(u32 c : range(channels)) {
+      auto& channel = _channels[c];
+      const f64* source = samples + offset * channels + c;
+      for(u32 n : range(length)) {
+        block[n] = source[n * channels] + 1e-25;  //constant offset used to suppress denormals
       }
+      for(auto& filter : channel.filters) {
+        switch(filter.mode) {
+        case Filter::Mode::OnePole: filter.onePole.process(block, length); break;
+        case Filter::Mode::Biquad: filter.biquad.process(block, length); break;
+        }
+      }
+      for(auto& filter : channel.nyquist) {
+        filter.process(block, length);
+      }
+      channel.resampler.write(block, length);
     }
-    for(auto& filter : _channels[c].nyquist) {
-      sample = filter.process(sample);
-    }
-    _channels[c].resampler.write(sample);
   }
 
   //if there are samples pending, then alert the frontend to possibly process them.
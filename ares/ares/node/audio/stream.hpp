@@ -21,6 +21,7 @@ struct Stream : Audio {
   auto pending() const -> bool;
   auto read(f64 samples[]) -> u32;
   auto write(const f64 samples[]) -> void;
+  auto write(const f64 samples[], u32 frames) -> void;
 
   template<typename... P>
   auto frame(P&&... p) -> void {
@@ -42,6 +43,7 @@ protected:
     vector<DSP::IIR::Biquad> nyquist;
     DSP::Resampler::Cubic resampler;
   };
+  static constexpr u32 Block = 256;  //frames filtered at a time
   vector<Channel> _channels;
   f64 _frequency = 48000.0;
   f64 _resamplerFrequency = 48000.0;
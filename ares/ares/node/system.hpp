@@ -7,7 +7,9 @@ struct System : Object {
   auto power(bool reset = false) -> void { if(_power) return _power(reset); }
   auto save() -> void { if(_save) return _save(); }
   auto unload() -> void { if(_unload) return _unload(); }
-  auto serialize(bool synchronize = true) -> serializer { if(_serialize) return _serialize(synchronize); return {}; }
+  auto serialize(bool synchronize = true) -> serializer { if(_serialize) return _serialize(synchronize, {}); return {}; }
+  //reuses the storage of an existing serializer, so that repeated snapshots do not reallocate
+  auto serialize(serializer& s, bool synchronize = true) -> bool { if(!_serialize) return false; s = _serialize(synchronize, std::move(s)); return true; }
   auto unserialize(serializer& s) -> bool { if(_unserialize) return _unserialize(s); return false; }
 
   auto setGame(function<string ()> game) -> void { _game = game; }
@@ -15,7 +17,7 @@ struct System : Object {
   auto setPower(function<void (bool)> power) -> void { _power = power; }
   auto setSave(function<void ()> save) -> void { _save = save; }
   auto setUnload(function<void ()> unload) -> void { _unload = unload; }
-  auto setSerialize(function<serializer (bool)> serialize) -> void { _serialize = serialize; }
+  auto setSerialize(function<serializer (bool, serializer)> serialize) -> void { _serialize = serialize; }
   auto setUnserialize(function<bool (serializer&)> unserialize) -> void { _unserialize = unserialize; }
 
 protected:
@@ -24,6 +26,6 @@ protected:
   function<void (bool)> _power;
   function<void ()> _save;
   function<void ()> _unload;
-  function<serializer (bool)> _serialize;
+  function<serializer (bool, serializer)> _serialize;
   function<bool (serializer&)> _unserialize;
 };
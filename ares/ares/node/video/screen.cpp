@@ -5,6 +5,7 @@ Screen::Screen(string name, u32 width, u32 height) : Video(name) {
   if(width && height) {
     _inputA = new u32[width * height]();
     _inputB = new u32[width * height]();
+    _inputC = new u32[width * height]();
     _output = new u32[width * height]();
     _rotate = new u32[width * height]();
 
@@ -16,26 +17,35 @@ Screen::Screen(string name, u32 width, u32 height) : Video(name) {
 
 Screen::~Screen() {
   if constexpr(ares::Video::Threaded) {
-    if(_canvasWidth && _canvasHeight) {
-      _kill = true;
-      _thread.join();
-    }
+    if(_canvasWidth && _canvasHeight) kill();
   }
 }
 
+//presentation thread: sleeps until the emulator completes a frame, then presents it.
 auto Screen::main(uintptr_t) -> void {
-  while(!_kill) {
-    usleep(1);
-    if(_frame) {
-      refresh();
+  while(true) {
+    {
+      unique_lock<mutex> lock(_frameMutex);
+      _frameCondition.wait(lock, [&] { return _frame || _kill; });
+      if(_kill) return;
+      _inputB.swap(_inputC);
       _frame = false;
     }
+    refresh();
   }
 }
 
-auto Screen::quit() -> void {
-  _kill = true;
+auto Screen::kill() -> void {
+  {
+    lock_guard<mutex> lock(_frameMutex);
+    _kill = true;
+  }
+  _frameCondition.notify_one();
   _thread.join();
+}
+
+auto Screen::quit() -> void {
+  kill();
   _sprites.reset();
 }
 
@@ -43,6 +53,7 @@ auto Screen::power() -> void {
   lock_guard<recursive_mutex> lock(_mutex);
   memory::fill<u32>(_inputA.data(), _canvasWidth * _canvasHeight, _fillColor);
   memory::fill<u32>(_inputB.data(), _canvasWidth * _canvasHeight, _fillColor);
+  memory::fill<u32>(_inputC.data(), _canvasWidth * _canvasHeight, _fillColor);
   memory::fill<u32>(_output.data(), _canvasWidth * _canvasHeight, _fillColor);
   memory::fill<u32>(_rotate.data(), _canvasWidth * _canvasHeight, _fillColor);
 }
@@ -142,6 +153,11 @@ auto Screen::setRotation(u32 rotation) -> void {
   _rotation = rotation;
 }
 
+auto Screen::setClear(bool clear) -> void {
+  lock_guard<recursive_mutex> lock(_mutex);
+  _clear = clear;
+}
+
 auto Screen::setProgressive(bool progressiveDouble) -> void {
   lock_guard<recursive_mutex> lock(_mutex);
   _interlace = false;
@@ -177,14 +193,26 @@ auto Screen::colors(u32 colors, function<n64 (n32)> color) -> void {
 
 auto Screen::frame() -> void {
   if(runAhead()) return;
-  while(_frame) spinloop();
 
-  lock_guard<recursive_mutex> lock(_mutex);
-  _inputA.swap(_inputB);
-  _frame = true;
-  if constexpr(!ares::Video::Threaded) {
+  if constexpr(ares::Video::Threaded) {
+    //hand the completed frame to the presentation thread without waiting for it.
+    //if the previous frame has not been presented yet, it is replaced and counted as dropped.
+    bool dropped = false;
+    {
+      lock_guard<mutex> lock(_frameMutex);
+      _inputA.swap(_inputC);
+      dropped = _frame;
+      _frame = true;
+    }
+    _frameCondition.notify_one();
+    if(dropped) {
+      _dropped++;
+      if(_clear) memory::fill<u32>(_inputA.data(), _canvasWidth * _canvasHeight, _fillColor);
+    }
+  } else {
+    lock_guard<recursive_mutex> lock(_mutex);
+    _inputA.swap(_inputB);
     refresh();
-    _frame = false;
   }
 }
 
@@ -206,52 +234,26 @@ auto Screen::refresh() -> void {
   auto input  = _inputB.data();
   auto output = _output.data();
 
+  //color bleed is applied to each line while it is still in the cache.
+  //every line is bled, including interlaced lines that were not redrawn this frame.
   for(u32 y : range(height)) {
     auto source = input  + y * pitch;
     auto target = output + y * width;
 
     if(_interlace) {
       if((_interlaceField & 1) == (y & 1)) {
-        for(u32 x : range(width)) {
-          auto color = _palette[*source++];
-          *target++ = color;
-        }
+        refreshLine(target, source, width);
       }
     } else if(_progressive && _progressiveDouble) {
       source = input + (y & ~1) * pitch;
-      for(u32 x : range(width)) {
-        auto color = _palette[*source++];
-        *target++ = color;
-      }
+      refreshLine(target, source, width);
     } else if(_interframeBlending) {
-      n32 mask = 1 << 24 | 1 << 16 | 1 << 8 | 1 << 0;
-      for(u32 x : range(width)) {
-        auto a = *target;
-        auto b = _palette[*source++];
-        *target++ = (a + b - ((a ^ b) & mask)) >> 1;
-      }
+      refreshBlend(target, source, width);
     } else {
-      for(u32 x : range(width)) {
-        auto color = _palette[*source++];
-        *target++ = color;
-      }
+      refreshLine(target, source, width);
     }
-  }
 
-  if (_colorBleed) {
-    n32 mask = 1 << 24 | 1 << 16 | 1 << 8 | 1 << 0;
-    for (u32 y : range(height)) {
-      auto target = output + y * width;
-      for (u32 x : range(0, width, _colorBleedWidth)) {
-        for (u32 offset = 0; offset < _colorBleedWidth && (x + offset) < width; ++offset) {
-          u32 next = x + _colorBleedWidth;
-          if (next + offset >= width) next = x;
-          auto a = target[x + offset];
-          auto b = target[next + offset];
-          target[x + offset] = (a + b - ((a ^ b) & mask)) >> 1;
-        }
-      }
-    }
+    if(_colorBleed) refreshBleed(target, width);
   }
 
   for(auto& sprite : _sprites) {
@@ -274,15 +276,8 @@ auto Screen::refresh() -> void {
     }
   }
 
-  if(_rotation == 90) {
-    //rotate left
-    for(u32 y : range(height)) {
-      auto source = output + y * width;
-      for(u32 x : range(width)) {
-        auto target = _rotate.data() + (width - 1 - x) * height + y;
-        *target = *source++;
-      }
-    }
+  if(_rotation == 90 || _rotation == 270) {
+    refreshRotate(_rotate.data(), output, width, height);
     output = _rotate.data();
     swap(width, height);
     swap(viewWidth, viewHeight);
@@ -290,32 +285,129 @@ auto Screen::refresh() -> void {
 
   if(_rotation == 180) {
     //rotate upside down
-    for(u32 y : range(height)) {
-      auto source = output + y * width;
-      for(u32 x : range(width)) {
-        auto target = _rotate.data() + (height - 1 - y) * width + (width - 1 - x);
-        *target = *source++;
-      }
-    }
+    auto target = _rotate.data() + width * height;
+    for(u32 n : range(width * height)) *--target = output[n];
     output = _rotate.data();
   }
 
-  if(_rotation == 270) {
-    //rotate right
-    for(u32 y : range(height)) {
-      auto source = output + y * width;
-      for(u32 x : range(width)) {
-        auto target = _rotate.data() + x * height + (height - 1 - y);
-        *target = *source++;
+  platform->video(shared(), output + viewX + viewY * width, width * sizeof(u32), viewWidth, viewHeight);
+  if(_clear) memory::fill<u32>(_inputB.data(), width * height, _fillColor);
+}
+
+//averages each 8-bit channel of two colors, rounding down.
+//note that the carry out of the alpha channel is discarded.
+static inline auto average(u32 a, u32 b) -> u32 {
+  return (a + b - ((a ^ b) & 0x01010101)) >> 1;
+}
+
+#if defined(__AVX2__)
+static inline auto average(__m256i a, __m256i b) -> __m256i {
+  auto carry = _mm256_and_si256(_mm256_xor_si256(a, b), _mm256_set1_epi32(0x01010101));
+  return _mm256_srli_epi32(_mm256_sub_epi32(_mm256_add_epi32(a, b), carry), 1);
+}
+#endif
+
+#if defined(ARCHITECTURE_AMD64)
+static inline auto average(__m128i a, __m128i b) -> __m128i {
+  auto carry = _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi32(0x01010101));
+  return _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(a, b), carry), 1);
+}
+#elif defined(ARCHITECTURE_ARM64)
+static inline auto average(uint32x4_t a, uint32x4_t b) -> uint32x4_t {
+  auto carry = vandq_u32(veorq_u32(a, b), vdupq_n_u32(0x01010101));
+  return vshrq_n_u32(vsubq_u32(vaddq_u32(a, b), carry), 1);
+}
+#endif
+
+//converts one line of native colors to ARGB8888.
+auto Screen::refreshLine(u32* target, const u32* source, u32 length) -> void {
+  auto palette = _palette.data();
+  u32 x = 0;
+  #if defined(__AVX2__)
+  for(; x + 8 <= length; x += 8) {
+    auto index = _mm256_loadu_si256((const __m256i*)(source + x));
+    auto color = _mm256_i32gather_epi32((const int*)palette, index, sizeof(u32));
+    _mm256_storeu_si256((__m256i*)(target + x), color);
+  }
+  #endif
+  for(; x < length; x++) target[x] = palette[source[x]];
+}
+
+//converts one line of native colors to ARGB8888, blending it with the previous frame.
+auto Screen::refreshBlend(u32* target, const u32* source, u32 length) -> void {
+  auto palette = _palette.data();
+  u32 x = 0;
+  #if defined(__AVX2__)
+  for(; x + 8 <= length; x += 8) {
+    auto index = _mm256_loadu_si256((const __m256i*)(source + x));
+    auto color = _mm256_i32gather_epi32((const int*)palette, index, sizeof(u32));
+    auto previous = _mm256_loadu_si256((const __m256i*)(target + x));
+    _mm256_storeu_si256((__m256i*)(target + x), average(previous, color));
+  }
+  #elif defined(ARCHITECTURE_AMD64)
+  for(; x + 4 <= length; x += 4) {
+    auto color = _mm_setr_epi32(palette[source[x + 0]], palette[source[x + 1]], palette[source[x + 2]], palette[source[x + 3]]);
+    auto previous = _mm_loadu_si128((const __m128i*)(target + x));
+    _mm_storeu_si128((__m128i*)(target + x), average(previous, color));
+  }
+  #elif defined(ARCHITECTURE_ARM64)
+  for(; x + 4 <= length; x += 4) {
+    const u32 colors[4] = {palette[source[x + 0]], palette[source[x + 1]], palette[source[x + 2]], palette[source[x + 3]]};
+    auto previous = vld1q_u32(target + x);
+    vst1q_u32(target + x, average(previous, vld1q_u32(colors)));
+  }
+  #endif
+  for(; x < length; x++) target[x] = average(target[x], palette[source[x]]);
+}
+
+//blends each pixel with the pixel colorBleedWidth to its right, in place.
+//the pixels at the end of the line that have no such neighbor are blended with themselves.
+auto Screen::refreshBleed(u32* target, u32 length) -> void {
+  u32 offset = _colorBleedWidth;
+  u32 x = 0;
+  //the neighbors are read before they are overwritten, so whole vectors can be processed at once.
+  #if defined(__AVX2__)
+  for(; x + 8 + offset <= length; x += 8) {
+    auto a = _mm256_loadu_si256((const __m256i*)(target + x));
+    auto b = _mm256_loadu_si256((const __m256i*)(target + x + offset));
+    _mm256_storeu_si256((__m256i*)(target + x), average(a, b));
+  }
+  #endif
+  #if defined(ARCHITECTURE_AMD64)
+  for(; x + 4 + offset <= length; x += 4) {
+    auto a = _mm_loadu_si128((const __m128i*)(target + x));
+    auto b = _mm_loadu_si128((const __m128i*)(target + x + offset));
+    _mm_storeu_si128((__m128i*)(target + x), average(a, b));
+  }
+  #elif defined(ARCHITECTURE_ARM64)
+  for(; x + 4 + offset <= length; x += 4) {
+    vst1q_u32(target + x, average(vld1q_u32(target + x), vld1q_u32(target + x + offset)));
+  }
+  #endif
+  for(; x < length; x++) {
+    u32 next = x + offset < length ? x + offset : x;
+    target[x] = average(target[x], target[next]);
+  }
+}
+
+//rotates the image by 90 (left) or 270 (right) degrees.
+//this is done in small tiles, so that the column-order writes stay within the cache.
+auto Screen::refreshRotate(u32* target, const u32* source, u32 width, u32 height) -> void {
+  static constexpr u32 Tile = 32;
+  for(u32 ty = 0; ty < height; ty += Tile) {
+    u32 ly = min(height, ty + Tile);
+    for(u32 tx = 0; tx < width; tx += Tile) {
+      u32 lx = min(width, tx + Tile);
+      for(u32 y = ty; y < ly; y++) {
+        auto line = source + y * width;
+        if(_rotation == 90) {
+          for(u32 x = tx; x < lx; x++) target[(width - 1 - x) * height + y] = line[x];
+        } else {
+          for(u32 x = tx; x < lx; x++) target[x * height + (height - 1 - y)] = line[x];
+        }
       }
     }
-    output = _rotate.data();
-    swap(width, height);
-    swap(viewWidth, viewHeight);
   }
-
-  platform->video(shared(), output + viewX + viewY * width, width * sizeof(u32), viewWidth, viewHeight);
-  memory::fill<u32>(_inputB.data(), width * height, _fillColor);
 }
 
 auto Screen::refreshPalette() -> void {
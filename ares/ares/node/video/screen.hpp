@@ -5,6 +5,7 @@ struct Screen : Video {
   Screen(string name = {}, u32 width = 0, u32 height = 0);
   ~Screen();
   auto main(uintptr_t) -> void;
+  auto kill() -> void;
   auto quit() -> void;
   auto power() -> void;
 
@@ -18,6 +19,7 @@ struct Screen : Video {
   auto aspectY() const -> f64 { return _aspectY; }
   auto overscan() const -> bool { return _overscan; }
   auto colors() const -> u32 { return _colors; }
+  auto dropped() const -> u64 { return _dropped; }
   auto pixels(bool frame = 0) -> array_span<u32>;
 
   auto saturation() const -> double { return _saturation; }
@@ -28,6 +30,7 @@ struct Screen : Video {
   auto colorBleed() const -> bool { return _colorBleed; }
   auto interframeBlending() const -> bool { return _interframeBlending; }
   auto rotation() const -> u32 { return _rotation; }
+  auto clear() const -> bool { return _clear; }
 
   auto resetPalette() -> void;
   auto resetSprites() -> void;
@@ -49,6 +52,7 @@ struct Screen : Video {
   auto setColorBleedWidth(u32 width) -> void;
   auto setInterframeBlending(bool interframeBlending) -> void;
   auto setRotation(u32 rotation) -> void;
+  auto setClear(bool clear) -> void;
 
   auto setProgressive(bool progressiveDouble = false) -> void;
   auto setInterlace(bool interlaceField) -> void;
@@ -65,6 +69,10 @@ struct Screen : Video {
 
 private:
   auto refreshPalette() -> void;
+  auto refreshLine(u32* target, const u32* source, u32 length) -> void;
+  auto refreshBlend(u32* target, const u32* source, u32 length) -> void;
+  auto refreshBleed(u32* target, u32 length) -> void;
+  auto refreshRotate(u32* target, const u32* source, u32 width, u32 height) -> void;
 
 protected:
   u32  _canvasWidth = 0;
@@ -85,10 +93,12 @@ protected:
   bool _interframeBlending = false;
   bool _overscan = true;
   u32  _rotation = 0;  //counter-clockwise (90 = left, 270 = right)
+  bool _clear = true;  //false when the core draws every pixel of every frame
 
   function<n64 (n32)> _color;
-  unique_pointer<u32[]> _inputA;
-  unique_pointer<u32[]> _inputB;
+  unique_pointer<u32[]> _inputA;  //frame being drawn by the emulator
+  unique_pointer<u32[]> _inputB;  //frame being presented
+  unique_pointer<u32[]> _inputC;  //completed frame waiting to be presented
   unique_pointer<u32[]> _output;
   unique_pointer<u32[]> _rotate;
   unique_pointer<u32[]> _palette;
@@ -97,8 +107,11 @@ protected:
 //unserialized:
   nall::thread _thread;
   recursive_mutex _mutex;
+  mutex _frameMutex;
+  condition_variable _frameCondition;
   atomic<bool> _kill = false;
-  atomic<bool> _frame = false;
+  bool _frame = false;  //guarded by _frameMutex
+  atomic<u64> _dropped = 0;
   function<void ()> _refresh;
   bool _progressive = false;
   bool _progressiveDouble = false;
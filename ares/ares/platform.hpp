@@ -20,7 +20,6 @@ struct Platform {
   virtual auto video(Node::Video::Screen, const u32* data, u32 pitch, u32 width, u32 height) -> void {}
   virtual auto audio(Node::Audio::Stream) -> void {}
   virtual auto input(Node::Input::Input) -> void {}
-  virtual auto cheat(u32 addr) -> maybe<u32> { return nothing; }
 };
 
 extern Platform* platform;
@@ -1,5 +1,6 @@
 inline auto Scheduler::reset() -> void {
   _threads.reset();
+  _switches = 0;
 }
 
 inline auto Scheduler::threads() const -> u32 {
@@ -9,6 +10,7 @@ inline auto Scheduler::threads() const -> u32 {
 inline auto Scheduler::thread(u32 uniqueID) const -> maybe<Thread&> {
   for(auto& thread : _threads) {
     if(thread->_uniqueID == uniqueID) return *thread;
+    if(thread->_uniqueID > uniqueID) break;
   }
   return {};
 }
@@ -16,9 +18,13 @@ inline auto Scheduler::thread(u32 uniqueID) const -> maybe<Thread&> {
 //if threads A and B both have a clock value of 0, it is ambiguous which should run first.
 //to resolve this, a uniqueID is assigned to each thread when appended to the scheduler.
 //the first unused ID is selected, to avoid the uniqueID growing in an unbounded fashion.
+//as threads are kept sorted by uniqueID, the first unused ID is the first gap in the list.
 inline auto Scheduler::uniqueID() const -> u32 {
   u32 uniqueID = 0;
-  while(thread(uniqueID)) uniqueID++;
+  for(auto& thread : _threads) {
+    if(thread->_uniqueID != uniqueID) break;
+    uniqueID++;
+  }
   return uniqueID;
 }
 
@@ -44,7 +50,9 @@ inline auto Scheduler::append(Thread& thread) -> bool {
   if(_threads.find(&thread)) return false;
   thread._uniqueID = uniqueID();
   thread._clock = maximum() + thread._uniqueID;
+  //the new uniqueID fills the first gap in the list, so that is where the thread belongs.
   _threads.append(&thread);
+  for(u32 n = _threads.size() - 1; n > thread._uniqueID; n--) swap(_threads[n], _threads[n - 1]);
   return true;
 }
 
@@ -64,6 +72,7 @@ inline auto Scheduler::enter(Mode mode) -> Event {
   if(mode == Mode::Run) {
     _mode = mode;
     _host = co_active();
+    _switches++;
     co_switch(_resume);
     platform->event(_event);
     return _event;
@@ -76,6 +85,7 @@ inline auto Scheduler::enter(Mode mode) -> Event {
         _mode = Mode::SynchronizePrimary;
         _host = co_active();
         do {
+          _switches++;
           co_switch(_resume);
           platform->event(_event);
         } while(_event != Event::Synchronize);
@@ -87,6 +97,7 @@ inline auto Scheduler::enter(Mode mode) -> Event {
         _host = co_active();
         _resume = thread->handle();
         do {
+          _switches++;
           co_switch(_resume);
           platform->event(_event);
         } while(_event != Event::Synchronize);
@@ -100,14 +111,26 @@ inline auto Scheduler::enter(Mode mode) -> Event {
 
 inline auto Scheduler::exit(Event event) -> void {
   //subtract the minimum time from all threads to prevent clock overflow.
-  auto reduce = minimum();
-  for(auto& thread : _threads) {
-    thread->_clock -= reduce;
+  //this is only needed once the clocks have advanced by around one emulated second:
+  //any single thread's clock is an upper bound on the minimum, so this is usually O(1).
+  if(_threads && _threads.first()->_clock >= Thread::Second) {
+    auto reduce = minimum();
+    if(reduce >= Thread::Second) {
+      for(auto& thread : _threads) {
+        thread->_clock -= reduce;
+      }
+    }
+  }
+
+  if(event == Event::Frame) {
+    _contextSwitches = _switches;
+    _switches = 0;
   }
 
   //return to the thread that entered the scheduler originally.
   _event = event;
   _resume = co_active();
+  _switches++;
   co_switch(_host);
 }
 
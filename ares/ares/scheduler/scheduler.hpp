@@ -38,7 +38,8 @@ private:
   cothread_t _primary = nullptr;  //primary thread (used to synchronize components)
   Mode _mode = Mode::Run;
   Event _event = Event::Step;
-  vector<Thread*> _threads;
+  vector<Thread*> _threads;       //sorted by uniqueID
+  u64 _switches = 0;              //context switches in the current frame
   bool _synchronize = false;
 
   friend struct Thread;
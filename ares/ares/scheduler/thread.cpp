@@ -89,6 +89,7 @@ inline auto Thread::synchronize(Thread& thread, P&&... p) -> void {
     //disable synchronization for auxiliary threads during scheduler synchronization.
     //synchronization can begin inside of this while loop.
     if(scheduler.synchronizing()) break;
+    scheduler._switches++;
     co_switch(thread.handle());
   }
   //convenience: allow synchronizing multiple threads with one function call.
@@ -35,7 +35,9 @@ auto SH2::instruction() -> void {
     // minimum cycle counts ensure that the recompiler is a net positive
     do {
       auto block = recompiler.block(PC - 4);
+      recompiler.shared().executing++;
       block->execute(*this);
+      recompiler.shared().executing--;
     } while (CCR < cyclesUntilRecompilerExit);
 
     // Reset the count as it may have been set to 0 for an early exit
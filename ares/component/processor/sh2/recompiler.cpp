@@ -30,16 +30,56 @@ auto SH2::Recompiler::mask(u8 address, u8 size) -> u64 {
   return smask & emask;
 }
 
+auto SH2::Recompiler::shared() -> Shared& {
+  static Shared shared;
+  return shared;
+}
+
+//releases all translated code; every instance must forget the blocks it has mapped
+auto SH2::Recompiler::Shared::flush() -> void {
+  print("SH2 allocator flush\n");
+  allocator.release();
+  blocks.reset();
+  for(auto recompiler : users) recompiler->discard();
+}
+
+auto SH2::Recompiler::reset() -> void {
+  generation = 0;
+  memory::jitprotect(false);
+  for(auto table : tables) {
+    if(!table) continue;
+    for(auto pool : table->pools) {
+      if(pool) pool->dirty = ~0ull;
+    }
+  }
+  memory::jitprotect(true);
+}
+
+auto SH2::Recompiler::discard() -> void {
+  generation = 0;
+  for(auto table : tables) {
+    if(table) *table = {};
+  }
+}
+
 auto SH2::Recompiler::invalidate(u32 address, u8 size) -> void {
-  auto pool = pools[address >> 8 & 0xffffff];
+  auto pool = find(address);
   if(!pool) return;
   memory::jitprotect(false);
   pool->dirty |= mask(address, size);
   memory::jitprotect(true);
 }
 
+auto SH2::Recompiler::find(u32 address) -> Pool* {
+  auto table = tables[address >> 20];
+  if(!table) return nullptr;
+  return table->pools[address >> 8 & 0xfff];
+}
+
 auto SH2::Recompiler::pool(u32 address) -> Pool* {
-  auto& pool = pools[address >> 8 & 0xffffff];
+  auto& table = tables[address >> 20];
+  if(!table) table = new Table{};
+  auto& pool = table->pools[address >> 8 & 0xfff];
   if(!pool) {
     pool = (Pool*)allocator.acquire(sizeof(Pool));
     memory::jitprotect(false);
@@ -75,7 +115,9 @@ auto SH2::Recompiler::block(u32 address) -> Block* {
 
   BlockHashPair pair;
   pair.hashcode = hashcode;
-  if(auto result = blocks.find(pair)) {
+  pair.prologue = callInstructionPrologue;
+  pair.owner = Accuracy::CachedInterpreter ? &self : nullptr;
+  if(auto result = shared().blocks.find(pair)) {
     memory::jitprotect(false);
     pool(address)->blocks[address >> 1 & 0x7f] = result->block;
     memory::jitprotect(true);
@@ -88,7 +130,7 @@ auto SH2::Recompiler::block(u32 address) -> Block* {
   memory::jitprotect(true);
 
   pair.block = block;
-  blocks.insert(pair);
+  shared().blocks.insert(pair);
 
   return block;
 }
@@ -114,10 +156,9 @@ auto SH2::Recompiler::hash(u32 address, u8 size) -> u64 {
 }
 
 auto SH2::Recompiler::emit(u32 address) -> Block* {
-  if(unlikely(allocator.available() < 1_MiB)) {
-    print("SH2 allocator flush\n");
-    allocator.release();
-    reset();
+  //another instance may be suspended inside a block, in which case flushing is deferred until it has exited
+  if(unlikely(allocator.available() < 1_MiB && !shared().executing)) {
+    shared().flush();
   }
 
   auto block = (Block*)allocator.acquire(sizeof(Block));
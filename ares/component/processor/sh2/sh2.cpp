@@ -64,9 +64,12 @@ auto SH2::power(bool reset) -> void {
   cache.power();
 
   if constexpr(Accuracy::Recompiler) {
-    if(!reset) {
+    //the code buffer is shared by every instance, and is acquired when the first is powered on
+    if(!reset && recompiler.shared().users.first() == &recompiler) {
       auto buffer = ares::Memory::FixedAllocator::get().tryAcquire(64_MiB);
-      recompiler.allocator.resize(64_MiB, bump_allocator::executable, buffer);
+      recompiler.shared().allocator.resize(64_MiB, bump_allocator::executable, buffer);
+      recompiler.shared().blocks.reset();
+      for(auto user : recompiler.shared().users) user->discard();
     }
     recompiler.reset();
   }
@@ -251,7 +251,11 @@ struct SH2 {
 
   struct Recompiler : recompiler::generic {
     SH2& self;
-    Recompiler(SH2& self) : self(self), generic(allocator) {}
+    Recompiler(SH2& self) : self(self), generic(shared().allocator) { shared().users.append(this); }
+    ~Recompiler() {
+      shared().users.removeByValue(this);
+      for(auto table : tables) delete table;
+    }
 
     struct Block {
       auto execute(SH2& self) -> void {
@@ -268,25 +272,45 @@ struct SH2 {
       Block* blocks[1 << 7];
     };
 
+    //pools are reached through a sparse two-level table, as only a few megabytes of the address space hold code
+    struct Table {
+      Pool* pools[1 << 12];
+    };
+
     struct BlockHashPair {
-      auto operator==(const BlockHashPair& source) const -> bool { return hashcode == source.hashcode; }
+      auto operator==(const BlockHashPair& source) const -> bool {
+        return hashcode == source.hashcode && prologue == source.prologue && owner == source.owner;
+      }
       auto hash() const -> u32 { return hashcode; }
 
       Block* block;
       u64 hashcode;
+      bool prologue;  //block calls instructionPrologue before each instruction
+      SH2* owner;     //instance the block embeds a pointer to, or nullptr if any instance may execute it
     };
 
-    auto reset() -> void {
-      generation = 0;
-      blocks.reset();
-      for(u32 index : range(1 << 24)) pools[index] = nullptr;
-    }
+    //translated code is shared between every SH-2 instance, so that code run by both
+    //the master and slave CPUs of the 32X is compiled once, into a single code buffer.
+    struct Shared {
+      auto flush() -> void;
+
+      bump_allocator allocator;
+      hashset<BlockHashPair> blocks;
+      vector<Recompiler*> users;
+      u32 executing = 0;  //instances currently inside a block, which prevents the code buffer from being flushed
+    };
+    static auto shared() -> Shared&;
+
+    //forgets which blocks are mapped at which addresses; compiled blocks remain available by their contents
+    auto reset() -> void;
+    auto discard() -> void;
 
     auto invalidateCached() -> void {
       generation++;
     }
 
     auto invalidate(u32 address, u8 size) -> void;
+    auto find(u32 address) -> Pool*;
     auto pool(u32 address) -> Pool*;
     auto block(u32 address) -> Block*;
     auto measure(u32 address) -> u8;
@@ -303,10 +327,8 @@ struct SH2 {
     bool callInstructionPrologue = false;
     bool inDelaySlot;
     u32 generation;
-    bump_allocator allocator;
-    hashset<BlockHashPair> blocks;
     u16 instructions[1 << 7];
-    Pool* pools[1 << 24];
+    Table* tables[1 << 12] = {};
   } recompiler{*this};
 
   #include "sh7604/sh7604.hpp"
@@ -29,7 +29,7 @@ struct System {
   auto power(bool reset = false) -> void;
 
   //serialization.cpp
-  auto serialize(bool synchronize) -> serializer;
+  auto serialize(bool synchronize, serializer = {}) -> serializer;
   auto unserialize(serializer&) -> bool;
 
   u8 bios[0x2000];
@@ -7,7 +7,7 @@
 //$4018-ffff = Cartridge
 
 inline auto CPU::readBus(n16 address) -> n8 {
-  if(auto result = platform->cheat(address)) return *result;
+  if(auto result = cheats.find(address)) return *result;
   n8 data = cartridge.readPRG(address, MDR);
   if(address <= 0x1fff) return ram.read(address);
   if(address <= 0x3fff) return ppu.readIO(address);
@@ -48,7 +48,7 @@ struct System {
   auto power(bool reset = false) -> void;
 
   //serialization.cpp
-  auto serialize(bool synchronize) -> serializer;
+  auto serialize(bool synchronize, serializer = {}) -> serializer;
   auto unserialize(serializer&) -> bool;
 
   struct Information {
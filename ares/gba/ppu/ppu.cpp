@@ -35,6 +35,7 @@ auto PPU::load(Node::Object parent) -> void {
   screen->setScale(1.0, 1.0);
   screen->setAspect(1.0, 1.0);
   screen->setViewport(0, 0, 240, 160);
+  screen->setClear(false);  //all 240x160 pixels are drawn every frame
 
   colorEmulation = screen->append<Node::Setting::Boolean>("Color Emulation", true, [&](auto value) {
     screen->resetPalette();
@@ -144,6 +145,8 @@ auto PPU::main() -> void {
 }
 
 auto PPU::frame() -> void {
+  //the Game Boy Player logo must be detected before the frame is handed off for presentation
+  if(Model::GameBoyPlayer()) player.frame();
   screen->frame();
   scheduler.exit(Event::Frame);
 }
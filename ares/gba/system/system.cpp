@@ -31,7 +31,6 @@ auto System::game() -> string {
 
 auto System::run() -> void {
   scheduler.enter();
-  if(GameBoyAdvance::Model::GameBoyPlayer()) player.frame();
 }
 
 auto System::load(Node::System& root, string name) -> bool {
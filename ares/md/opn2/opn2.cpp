@@ -24,7 +24,10 @@ auto OPN2::unload() -> void {
 auto OPN2::main() -> void {
   step(144);
   auto samples = YM2612::clock();
-  stream->frame(samples[0] / 32768.0, samples[1] / 32768.0);
+  if(runAhead()) return;
+  buffer[buffered++] = samples[0] / 32768.0;
+  buffer[buffered++] = samples[1] / 32768.0;
+  if(buffered == 2 * 256) stream->write(buffer, 256), buffered = 0;
 }
 
 auto OPN2::step(u32 clocks) -> void {
@@ -34,6 +37,7 @@ auto OPN2::step(u32 clocks) -> void {
 
 auto OPN2::power(bool reset) -> void {
   YM2612::power();
+  buffered = 0;
   Thread::create(system.frequency() / 7.0, {&OPN2::main, this});
 }
 
@@ -4,6 +4,10 @@ struct OPN2 : YM2612, Thread {
   Node::Object node;
   Node::Audio::Stream stream;
 
+  //frames are collected here and written to the stream in blocks
+  f64 buffer[2 * 256];
+  u32 buffered = 0;
+
   //opn2.cpp
   auto load(Node::Object) -> void;
   auto unload() -> void;
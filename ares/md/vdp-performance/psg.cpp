@@ -21,7 +21,10 @@ auto VDP::PSG::main() -> void {
   output += volume[channels[1]];
   output += volume[channels[2]];
   output += volume[channels[3]];
-  stream->frame(output / 4.0 * 0.625);
+  if(!runAhead()) {
+    buffer[buffered++] = output / 4.0 * 0.625;
+    if(buffered == 256) stream->write(buffer, 256), buffered = 0;
+  }
   step(16);
 }
 
@@ -33,6 +36,7 @@ auto VDP::PSG::step(u32 clocks) -> void {
 auto VDP::PSG::power(bool reset) -> void {
   SN76489::power();
   Thread::create(system.frequency() / 15.0, {&PSG::main, this});
+  buffered = 0;
 
   for(u32 level : range(15)) {
     volume[level] = pow(2, level * -2.0 / 6.0);
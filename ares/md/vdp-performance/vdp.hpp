@@ -67,6 +67,10 @@ struct VDP : Thread {
     Node::Object node;
     Node::Audio::Stream stream;
 
+    //frames are collected here and written to the stream in blocks
+    f64 buffer[256];
+    u32 buffered = 0;
+
     //psg.cpp
     auto load(Node::Object) -> void;
     auto unload() -> void;
@@ -19,6 +19,11 @@ struct Accuracy {
     static constexpr bool SIMD = !SISD;
   };
 
+  struct RDP {
+    //draws software rendered primitives on worker threads
+    static constexpr bool Threaded = 1 & !Reference;
+  };
+
   struct RDRAM {
     static constexpr bool Broadcasting = 0;
   };
@@ -37,6 +37,11 @@ auto CPU::main() -> void {
   }
 
   vi.refreshed = false;
+
+  if constexpr(Accuracy::CPU::Recompiler) {
+    recompiler.previous = recompiler.statistics;
+    recompiler.statistics = {};
+  }
 }
 
 auto CPU::synchronize() -> void {
@@ -103,13 +108,17 @@ auto CPU::instruction() -> void {
     // As memory writes cause recompiler block invalidation, this shouldn't be detectable.
     if (auto address = devirtualizeFast(ipu.pc)) {
       if(auto block = recompiler.fastFetchBlock(address)) {
+        recompiler.link(block);
         block->execute(*this);
         return;
       }
     }
 
     if (auto address = devirtualize(ipu.pc)) {
-      auto block = recompiler.block(ipu.pc, *address, GDB::server.hasBreakpoints());
+      bool singleInstruction = GDB::server.hasBreakpoints();
+      auto block = recompiler.block(ipu.pc, *address, singleInstruction);
+      if(singleInstruction) recompiler.exit = nullptr;
+      else recompiler.link(block);
       block->execute(*this);
     }
   }
@@ -162,6 +171,7 @@ auto CPU::power(bool reset) -> void {
   icache.power(reset);
   dcache.power(reset);
   for(auto& entry : tlb.entry) entry = {}, entry.synchronize();
+  tlb.flush();
   tlb.physicalAddress = 0;
   for(auto& r : ipu.r) r.u64 = 0;
   ipu.lo.u64 = 0;
@@ -20,12 +20,18 @@ struct CPU : Thread {
     auto tlbStoreInvalid(u64 address) -> void;
     auto tlbStoreMiss(u64 address) -> void;
 
+    auto recompiler() -> string;
+
     struct Tracer {
       Node::Debugger::Tracer::Instruction instruction;
       Node::Debugger::Tracer::Notification exception;
       Node::Debugger::Tracer::Notification interrupt;
       Node::Debugger::Tracer::Notification tlb;
     } tracer;
+
+    struct Properties {
+      Node::Debugger::Properties recompiler;
+    } properties;
   } debugger;
 
   //cpu.cpp
@@ -238,6 +244,17 @@ struct CPU : Thread {
     auto loadFast(u64 vaddr) -> Match;
     auto store(u64 vaddr) -> Match;
     auto store(u64 vaddr, const Entry& entry) -> maybe<Match>;
+    auto lookup(u64 vaddr) const -> u32;
+    auto fill(u64 vaddr, const Entry& entry, bool lo) -> void;
+    auto flush() -> void;
+
+    //direct-mapped translations of 32-bit virtual pages, filled as entries match.
+    //emptied whenever the TLB entries or the address space ID change.
+    struct Pages {
+      enum : u32 { Valid = 1 << 0, Dirty = 1 << 1, Cached = 1 << 2 };
+      u32 lookup[1 << 20];  //physical page | flags, or zero when untranslated
+      vector<u32> filled;
+    } pages;
 
     struct TlbCache { ;
       static constexpr int entries = 4;
@@ -850,53 +867,108 @@ struct CPU : Thread {
     CPU& self;
     Recompiler(CPU& self) : self(self), generic(allocator) {}
 
+    struct Block;
+
+    //a jump from the end of one block directly into the body of the block that ran next.
+    //the source block follows it whenever ipu.pc equals vaddr, without returning to CPU::instruction().
+    struct Link {
+      u64 vaddr;
+      u8* code;        //body of target, or nullptr when unlinked
+      Block* target;
+      Link* next;      //the other links into target
+      Link* previous;
+    };
+
     struct Block {
       auto execute(CPU& self) -> void {
         ((void (*)(CPU*, r64*, r64*))code)(&self, &self.ipu.r[16], &self.fpu.r[16]);
       }
 
       u8* code;
+      u8* body;        //code past the prologue, entered by linked blocks
+      u32 size;        //number of instructions compiled into this block
+      u32 victim;      //the link replaced when both are in use
+      Link links[2];   //the most recent successors: taken and not taken, or the last two indirect targets
+      Link* incoming;  //links from other blocks into this one
     };
 
+    //a pool holds the blocks that begin within a 256-byte page of guest memory.
+    //blocks never cross a page boundary, so the pool is also the set of all blocks that overlap the page.
     struct Pool {
       Block* blocks[1 << 6];
+      u64 coverage;  //bit n is set when instruction n of this page belongs to any block
+    };
+
+    struct Statistics {
+      u32 compiled = 0;  //blocks compiled
+      u32 evicted = 0;   //blocks invalidated by writes to guest memory
+      u32 flushed = 0;   //times the entire code buffer was flushed
+      u32 linked = 0;    //block exits linked to their successor
     };
 
+    //a chain of linked blocks runs until this many clocks have passed since the last CPU::synchronize(),
+    //which bounds how far the other components can fall behind the CPU.
+    static constexpr s64 Budget = 512;
+
     auto reset() -> void {
       for(u32 index : range(1 << 21)) pools[index] = nullptr;
+      exit = nullptr;
     }
 
     auto invalidate(u32 address) -> void {
-      /* FIXME: Recompiler shouldn't be so aggressive with pool eviction
-       * Sometimes there are overlapping blocks, so clearing just one block
-       * isn't sufficient and causes some games to crash (Jet Force Gemini)
-       * the recompiler needs to be smarter with block tracking
-       * Until then, clear the entire pool and live with the performance hit.
-      */
-      #if 1
-      invalidatePool(address);
-      #else
       auto pool = pools[address >> 8 & 0x1fffff];
       if(!pool) return;
-      memory::jitprotect(false);
-      pool->blocks[address >> 2 & 0x3f] = nullptr;
-      memory::jitprotect(true);
-      #endif
+      u64 mask = 1ull << (address >> 2 & 0x3f);
+      if(pool->coverage & mask) evict(pool, mask);
     }
 
     auto invalidatePool(u32 address) -> void {
-      pools[address >> 8 & 0x1fffff] = nullptr;
+      auto& pool = pools[address >> 8 & 0x1fffff];
+      if(!pool) return;
+      evict(pool, ~0ull);
+      pool = nullptr;
     }
 
     auto invalidateRange(u32 address, u32 length) -> void {
-      for (u32 s = 0; s < length; s += 256)
-        invalidatePool(address + s);
-      invalidatePool(address + length - 1);
+      if(!length) return;
+      u32 first = address >> 2;
+      u32 last = address + length - 1 >> 2;
+      while(first <= last) {
+        u32 count = min(last - first + 1, 64 - (first & 0x3f));
+        if(auto pool = pools[first >> 6 & 0x1fffff]) {
+          u64 mask = (count == 64 ? ~0ull : (1ull << count) - 1) << (first & 0x3f);
+          if(pool->coverage & mask) evict(pool, mask);
+        }
+        first += count;
+      }
+    }
+
+    //removes every block of the pool that contains any of the instructions in mask.
+    auto evict(Pool* pool, u64 mask) -> void {
+      memory::jitprotect(false);
+      u64 coverage = 0;
+      for(u32 index : range(1 << 6)) {
+        auto block = pool->blocks[index];
+        if(!block) continue;
+        u64 covers = (block->size == 64 ? ~0ull : (1ull << block->size) - 1) << index;
+        if(covers & mask) {
+          unlink(block);
+          pool->blocks[index] = nullptr;
+          statistics.evicted++;
+        } else {
+          coverage |= covers;
+        }
+      }
+      pool->coverage = coverage;
+      memory::jitprotect(true);
     }
 
     auto pool(u32 address) -> Pool*;
     auto block(u32 vaddr, u32 address, bool singleInstruction = false) -> Block*;
     auto fastFetchBlock(u32 address) -> Block*;
+    auto link(Block* target) -> void;
+    auto unlink(Block* block) -> void;
+    auto detach(Link& link) -> void;
 
     auto emit(u32 vaddr, u32 address, bool singleInstruction = false) -> Block*;
     auto emitEXECUTE(u32 instruction) -> bool;
@@ -906,9 +978,71 @@ struct CPU : Thread {
     auto emitFPU(u32 instruction) -> bool;
     auto emitCOP2(u32 instruction) -> bool;
 
+    auto emitBranch(sljit_s32 flag, s16 offset, bool likely) -> void;
+    auto emitTake(op_base target) -> void;
+    auto emitReserved() -> sljit_jump*;
+    auto emitDataCache(op_base base, s16 offset, u32 size, bool store) -> vector<sljit_jump*>;
+    auto emitLoad(u32 instruction, u32 size, bool sign, void (CPU::*function)(r64&, cr64&, s16)) -> void;
+    auto emitStore(u32 instruction, u32 size, void (CPU::*function)(cr64&, cr64&, s16)) -> void;
+    auto emitChain(Block* block) -> void;
+
+    //guest GPRs are cached in the host's callee-saved registers that remain after the three block arguments.
+    //the cache is block-local: it is spilled before every helper call and at every block exit.
+    static constexpr u32 Cached = SLJIT_NUMBER_OF_SAVED_REGISTERS - 3 < 6 ? SLJIT_NUMBER_OF_SAVED_REGISTERS - 3 : 6;
+
+    struct Slot {
+      u32  guest;   //0 when free (r0 is never cached)
+      u32  used;    //allocation order, for least-recently-used eviction
+      bool dirty;   //the host register is newer than ipu.r[guest]
+      bool pinned;  //operand of the instruction being emitted
+    };
+
+    template<typename T> auto field(T& member) -> mem {
+      return mem(sreg(0), (u8*)&member - (u8*)&self);
+    }
+
+    auto gpr(u32 n) -> mem;
+    auto allocate(u32 n, bool load) -> op_base;
+    auto src(u32 n) -> op_base;
+    auto src32(u32 n) -> op_base;
+    auto dst(u32 n, bool load = false) -> op_base;
+    auto reload(u32 n) -> void;
+    auto release() -> void;
+    auto dirty() const -> bool;
+    auto writeback() -> void;
+    auto flush() -> void;
+    auto sync() -> void;
+    auto testExit() -> void;
+    auto resume(u32 n) -> void;
+
+    //helpers see guest state through memory
+    template<typename F> auto call(F function) -> void {
+      sync();
+      flush();
+      generic::call(function);
+    }
+
+    //runs the interpreter implementation of an inlined instruction whose arguments are already set up
+    template<typename F> auto fallback(F function, u32 n) -> void {
+      writeback();
+      generic::call(function);
+      resume(n);
+    }
+
+    Slot slots[Cached];
+    u32  uses = 0;
+    u32  pending = 0;        //instructions whose pc and clock updates have not been emitted yet
+    bool caching = false;    //register cache and deferred epilogues are enabled for this block
+    bool inlineMemory = false;
+    bool stepping = false;   //branch.state is known to be Step when the current instruction begins
+    bool inlined = false;    //the current instruction ran without helper calls and cannot branch
+
     bool callInstructionPrologue = false;
+    Block* exit = nullptr;  //block that last returned through a chain miss, linked by the next dispatch
     bump_allocator allocator;
     Pool* pools[1 << 21];  //2_MiB * sizeof(void*) == 16_MiB
+    Statistics statistics;  //current frame
+    Statistics previous;    //previous frame
   } recompiler{*this};
 
   struct Disassembler {
@@ -12,6 +12,11 @@ auto CPU::Debugger::load(Node::Object parent) -> void {
   tracer.exception = parent->append<Node::Debugger::Tracer::Notification>("Exception", "CPU");
   tracer.interrupt = parent->append<Node::Debugger::Tracer::Notification>("Interrupt", "CPU");
   tracer.tlb = parent->append<Node::Debugger::Tracer::Notification>("TLB", "CPU");
+
+  if constexpr(Accuracy::CPU::Recompiler) {
+    properties.recompiler = parent->append<Node::Debugger::Properties>("Recompiler");
+    properties.recompiler->setQuery([&] { return recompiler(); });
+  }
 }
 
 auto CPU::Debugger::unload() -> void {
@@ -19,6 +24,7 @@ auto CPU::Debugger::unload() -> void {
   tracer.exception.reset();
   tracer.interrupt.reset();
   tracer.tlb.reset();
+  properties.recompiler.reset();
 }
 
 auto CPU::Debugger::instruction() -> void {
@@ -136,3 +142,13 @@ auto CPU::Debugger::tlbStoreMiss(u64 address) -> void {
     tracer.tlb->notify({"store miss: 0x", hex(address)});
   }
 }
+
+auto CPU::Debugger::recompiler() -> string {
+  auto& statistics = cpu.recompiler.previous;
+  string output;
+  output.append("Blocks Compiled: ", statistics.compiled, " (previous frame)\n");
+  output.append("Blocks Evicted: ", statistics.evicted, " (previous frame)\n");
+  output.append("Blocks Linked: ", statistics.linked, " (previous frame)\n");
+  output.append("Code Buffer Flushes: ", statistics.flushed, " (previous frame)\n");
+  return output;
+}
@@ -173,6 +173,7 @@ auto CPU::setControlRegister(n5 index, n64 data) -> void {
     scc.count = data.bit(0,31) << 1;
     break;
   case 10:  //entryhi
+    if(scc.tlb.addressSpaceID != data.bit(0,7)) tlb.flush();
     scc.tlb.addressSpaceID            = data.bit( 0, 7);
     scc.tlb.virtualAddress.bit(13,39) = data.bit(13,39);
     scc.tlb.region                    = data.bit(62,63);
@@ -339,6 +340,7 @@ auto CPU::TLBR() -> void {
     if(!scc.status.enable.coprocessor0) return exception.coprocessor0();
   }
   if(scc.index.tlbEntry >= TLB::Entries) return;
+  if(scc.tlb.addressSpaceID != tlb.entry[scc.index.tlbEntry].addressSpaceID) tlb.flush();
   scc.tlb = tlb.entry[scc.index.tlbEntry];
 }
 
@@ -348,6 +350,7 @@ auto CPU::TLBWI() -> void {
   }
   if(scc.index.tlbEntry >= TLB::Entries) return;
   devirtualizeCache = {};
+  tlb.flush();
   tlb.entry[scc.index.tlbEntry] = scc.tlb;
   tlb.entry[scc.index.tlbEntry].synchronize();
   debugger.tlbWrite(scc.index.tlbEntry);
@@ -360,6 +363,7 @@ auto CPU::TLBWR() -> void {
   u8 index = getControlRandom();
   if(index >= TLB::Entries) return;
   devirtualizeCache = {};
+  tlb.flush();
   tlb.entry[index] = scc.tlb;
   tlb.entry[index].synchronize();
   debugger.tlbWrite(index);
@@ -12,7 +12,10 @@ auto CPU::Recompiler::pool(u32 address) -> Pool* {
 auto CPU::Recompiler::block(u32 vaddr, u32 address, bool singleInstruction) -> Block* {
   if(auto block = pool(address)->blocks[address >> 2 & 0x3f]) return block;
   auto block = emit(vaddr, address, singleInstruction);
-  pool(address)->blocks[address >> 2 & 0x3f] = block;
+  auto pool = this->pool(address);
+  u32 index = address >> 2 & 0x3f;
+  pool->blocks[index] = block;
+  pool->coverage |= (block->size == 64 ? ~0ull : (1ull << block->size) - 1) << index;
   memory::jitprotect(true);
   return block;
 }
@@ -23,42 +26,110 @@ auto CPU::Recompiler::fastFetchBlock(u32 address) -> Block* {
   return nullptr;
 }
 
+//called by the dispatcher before it runs target: links the exit of the block that ran last to target.
+//only kseg0 and kseg1 addresses have a fixed translation that the generated code does not need to repeat.
+auto CPU::Recompiler::link(Block* target) -> void {
+  auto source = exit;
+  exit = nullptr;
+  if(!source || self.ipu.pc + 0x8000'0000 >= 0x4000'0000) return;
+  for(auto& link : source->links) {
+    if(link.vaddr == self.ipu.pc && link.target == target) return;
+  }
+
+  memory::jitprotect(false);
+  auto& link = !source->links[0].target ? source->links[0]
+             : !source->links[1].target ? source->links[1]
+             : source->links[source->victim ^= 1];
+  detach(link);
+  link.vaddr = self.ipu.pc;
+  link.code = target->body;
+  link.target = target;
+  link.next = target->incoming;
+  link.previous = nullptr;
+  if(link.next) link.next->previous = &link;
+  target->incoming = &link;
+  memory::jitprotect(true);
+  statistics.linked++;
+}
+
+//removes every link into and out of block (the code buffer must be writable)
+auto CPU::Recompiler::unlink(Block* block) -> void {
+  while(block->incoming) detach(*block->incoming);
+  for(auto& link : block->links) detach(link);
+}
+
+auto CPU::Recompiler::detach(Link& link) -> void {
+  if(!link.target) return;
+  if(link.previous) link.previous->next = link.next;
+  else link.target->incoming = link.next;
+  if(link.next) link.next->previous = link.previous;
+  link = {};
+}
+
 auto CPU::Recompiler::emit(u32 vaddr, u32 address, bool singleInstruction) -> Block* {
   if(unlikely(allocator.available() < 1_MiB)) {
     print("CPU allocator flush\n");
     allocator.release();
     reset();
+    statistics.flushed++;
   }
 
   auto block = (Block*)allocator.acquire(sizeof(Block));
-  beginFunction(3);
-
+  beginFunction(3, 3 + Cached);
+  for(auto& slot : slots) slot = {};
+  uses = 0;
+  pending = 0;
+  caching = !callInstructionPrologue;
+  inlineMemory = !singleInstruction;
+
+  u32 start = address;
   Thread thread;
   bool hasBranched = 0;
+  bool hasInlined = 0;
+  stepping = 0;
   while(true) {
     u32 instruction = bus.read<Word>(address, thread, "Ares Recompiler");
     if(callInstructionPrologue) {
       mov32(reg(1), imm(instruction));
       call(&CPU::instructionPrologue);
     }
+    inlined = 0;
     bool branched = emitEXECUTE(instruction);
+    release();
     if(unlikely(instruction == 0x1000'ffff  //beq 0,0,<pc>
              || instruction == (2 << 26 | vaddr >> 2 & 0x3ff'ffff))) {  //j <pc>
       //accelerate idle loops
       mov32(reg(1), imm(64 * 2));
       call(&CPU::step);
+      inlined = 0;
+    }
+    //when the previous instruction was inlined, it already fetched this icache line and left branch.state at Step:
+    //the epilogue then only advances pc and clock, and that is deferred until something can observe it.
+    bool deferred = caching && hasInlined && inlined && (vaddr & 0x1f);
+    if(deferred) {
+      pending++;
+    } else {
+      sync();
+      generic::call(&CPU::instructionEpilogue);
     }
-    call(&CPU::instructionEpilogue);
     vaddr += 4;
     address += 4;
     if(hasBranched || (address & 0xfc) == 0 || singleInstruction) break;  //block boundary
+    if(!deferred) testExit();
     hasBranched = branched;
-    testJumpEpilog();
+    hasInlined = inlined;
+    stepping = !branched && !(instruction >> 26 == 0x01 && (instruction >> 16 & 0x0c) == 0);  //REGIMM branches
   }
-  jumpEpilog();
+  sync();
+  writeback();
+  if(!singleInstruction) emitChain(block);
+  else jumpEpilog();
 
   memory::jitprotect(false);
-  block->code = endFunction();
+  *block = {};
+  block->code = endFunction(block->body);
+  block->size = address - start >> 2;
+  statistics.compiled++;
 
 //print(hex(PC, 8L), " ", instructions, " ", size(), "\n");
   return block;
@@ -92,6 +163,312 @@ auto CPU::Recompiler::emit(u32 vaddr, u32 address, bool singleInstruction) -> Bl
 #define n16 u16(instruction)
 #define n26 u32(instruction & 0x03ff'ffff)
 
+auto CPU::Recompiler::gpr(u32 n) -> mem {
+  return mem(IpuReg(r[0]) + n * sizeof(r64));
+}
+
+//returns the host register holding guest register n, loading it from memory when requested.
+//the least recently used unpinned slot is evicted when none are free; when caching is disabled or
+//every slot is pinned, the operand stays in memory.
+auto CPU::Recompiler::allocate(u32 n, bool load) -> op_base {
+  for(u32 index : range(Cached)) {
+    auto& slot = slots[index];
+    if(slot.guest != n) continue;
+    slot.used = ++uses;
+    slot.pinned = true;
+    return sreg(3 + index);
+  }
+  if(!caching) return gpr(n);
+
+  s32 victim = -1;
+  for(u32 index : range(Cached)) {
+    auto& slot = slots[index];
+    if(slot.pinned) continue;
+    if(!slot.guest) { victim = index; break; }
+    if(victim < 0 || slot.used < slots[victim].used) victim = index;
+  }
+  if(victim < 0) return gpr(n);
+
+  auto& slot = slots[victim];
+  if(slot.guest && slot.dirty) mov64(gpr(slot.guest), sreg(3 + victim));
+  slot = {n, ++uses, false, true};
+  if(load) mov64(sreg(3 + victim), gpr(n));
+  return sreg(3 + victim);
+}
+
+auto CPU::Recompiler::src(u32 n) -> op_base {
+  if(!n) return imm(0);
+  return allocate(n, true);
+}
+
+auto CPU::Recompiler::src32(u32 n) -> op_base {
+  if(!n) return imm(0);
+  auto operand = allocate(n, true);
+  if(operand.fst & SLJIT_MEM) return mem(IpuReg(r[0].u32) + n * sizeof(r64));
+  return operand;
+}
+
+//n must not be zero: writes to r0 are discarded by the caller
+auto CPU::Recompiler::dst(u32 n, bool load) -> op_base {
+  auto operand = allocate(n, load);
+  for(auto& slot : slots) {
+    if(slot.guest == n) slot.dirty = true;
+  }
+  return operand;
+}
+
+//refreshes the cached copy of n after a helper wrote it in memory
+auto CPU::Recompiler::reload(u32 n) -> void {
+  for(u32 index : range(Cached)) {
+    if(slots[index].guest == n) mov64(sreg(3 + index), gpr(n));
+  }
+}
+
+auto CPU::Recompiler::release() -> void {
+  for(auto& slot : slots) slot.pinned = false;
+}
+
+auto CPU::Recompiler::dirty() const -> bool {
+  for(auto& slot : slots) {
+    if(slot.guest && slot.dirty) return true;
+  }
+  return false;
+}
+
+//stores modified registers without changing the cache state (used on paths that leave the block)
+auto CPU::Recompiler::writeback() -> void {
+  for(u32 index : range(Cached)) {
+    auto& slot = slots[index];
+    if(slot.guest && slot.dirty) mov64(gpr(slot.guest), sreg(3 + index));
+  }
+}
+
+auto CPU::Recompiler::flush() -> void {
+  writeback();
+  for(auto& slot : slots) slot = {};
+}
+
+//applies the pc and clock updates of deferred instruction epilogues
+auto CPU::Recompiler::sync() -> void {
+  if(!pending) return;
+  add64(field(self.ipu.pc), field(self.ipu.pc), imm(pending * 4));
+  add64(field(self.clock), field(self.clock), imm(pending * 2));
+  pending = 0;
+}
+
+auto CPU::Recompiler::testExit() -> void {
+  if(!dirty()) return testJumpEpilog();
+  auto resume = cmp32_jump(reg(0), imm(0), flag_eq);
+  writeback();
+  jumpEpilog();
+  setLabel(resume);
+}
+
+//continues after an interpreter fallback: leaves the block if the helper raised an exception,
+//otherwise refreshes the cached copy of the register it wrote (if any).
+auto CPU::Recompiler::resume(u32 n) -> void {
+  auto step = cmp32_jump(field(self.branch.state), imm(Branch::Exception), flag_ne);
+  generic::call(&CPU::instructionEpilogue);
+  jumpEpilog();
+  setLabel(step);
+  if(n) reload(n);
+}
+
+//conditional branches: the comparison flags were just set, and the branch is taken when flag holds
+auto CPU::Recompiler::emitBranch(sljit_s32 flag, s16 offset, bool likely) -> void {
+  auto skip = jump(flag ^ 1);
+  mov64(reg(0), field(self.ipu.pc));
+  add64(reg(0), reg(0), imm(4 + (offset << 2)));
+  emitTake(reg(0));
+  auto done = jump();
+  setLabel(skip);
+  mov32(field(self.branch.state), imm(likely ? Branch::Discard : Branch::NotTaken));
+  setLabel(done);
+}
+
+auto CPU::Recompiler::emitTake(op_base target) -> void {
+  mov64(field(self.branch.pc), target);
+  mov32(field(self.branch.state), imm(Branch::Take));
+}
+
+//jumps when a 64-bit operation raises a reserved instruction exception (32-bit supervisor and user modes)
+auto CPU::Recompiler::emitReserved() -> sljit_jump* {
+  auto kernel = cmp32_jump(field(self.context.mode), imm(Context::Mode::Kernel), flag_eq);
+  auto reserved = cmp32_jump(field(self.context.bits), imm(32), flag_eq);
+  setLabel(kernel);
+  return reserved;
+}
+
+//inline data cache lookup for kseg0 accesses in 32-bit kernel mode.
+//on a hit, reg(1) holds the virtual address, reg(2) the cache line and reg(3) the addressed data (both relative
+//to the lines array); everything else (other segments, misaligned addresses, misses) takes one of the returned jumps.
+auto CPU::Recompiler::emitDataCache(op_base base, s16 offset, u32 size, bool store) -> vector<sljit_jump*> {
+  vector<sljit_jump*> miss;
+  sljit_sw lines = (u8*)&self.dcache.lines[0] - (u8*)&self;
+  sljit_sw segments = (u8*)&self.context.segment[0] - (u8*)&self;
+  sljit_sw pages = (u8*)&self.tlb.pages.lookup[0] - (u8*)&self;
+  u32 flags = TLB::Pages::Valid | TLB::Pages::Cached | (store ? TLB::Pages::Dirty : 0);
+  add64(reg(1), base, imm(offset));
+  if(size > Byte) {
+    test32(reg(1), imm(size - 1), set_z);
+    miss.append(jump(flag_nz));
+  }
+
+  //kseg0: the physical address is the low 29 bits of the virtual address
+  add64(reg(0), reg(1), imm(0x8000'0000));
+  cmp64(reg(0), imm(0x2000'0000), set_uge);
+  auto mapped = jump(flag_uge);
+  miss.append(cmp32_jump(field(self.context.segment[4]), imm(Context::Segment::Cached), flag_ne));
+  auto translated = jump();
+
+  //mapped segments: the physical page comes from the TLB page table
+  setLabel(mapped);
+  mov64_s32(reg(0), reg(1));
+  cmp64(reg(0), reg(1), set_z);
+  miss.append(jump(flag_nz));
+  and64(reg(0), reg(1), imm(0xe000'0000));
+  lshr64(reg(0), reg(0), imm(29 - 2));
+  add64(reg(0), reg(0), sreg(0));
+  miss.append(cmp32_jump(mem(reg(0), segments), imm(Context::Segment::Mapped), flag_ne));
+  and64(reg(0), reg(1), imm(0xffff'f000));
+  lshr64(reg(0), reg(0), imm(12 - 2));
+  add64(reg(0), reg(0), sreg(0));
+  mov32(reg(0), mem(reg(0), pages));
+  and32(reg(2), reg(0), imm(flags));
+  miss.append(cmp32_jump(reg(2), imm(flags), flag_ne));
+  setLabel(translated);
+
+  lshr64(reg(2), reg(1), imm(4));
+  and64(reg(2), reg(2), imm(0x1ff));
+  mul64(reg(2), reg(2), imm(sizeof(DataCache::Line)));
+  add64(reg(2), reg(2), sreg(0));
+  mov32_u8(reg(3), mem(reg(2), lines + offsetof(DataCache::Line, valid)));
+  miss.append(cmp32_jump(reg(3), imm(0), flag_eq));
+  and64(reg(0), reg(0), imm(~0xfff));
+  miss.append(cmp32_jump(reg(0), mem(reg(2), lines + offsetof(DataCache::Line, tag)), flag_ne));
+  and64(reg(3), reg(1), imm(15));
+  if(size == Byte) xor64(reg(3), reg(3), imm(3));
+  if(size == Half) xor64(reg(3), reg(3), imm(2));
+  add64(reg(3), reg(3), reg(2));
+  return miss;
+}
+
+//block exit: instead of returning to CPU::instruction(), continue directly into a linked successor when
+//nothing that the dispatcher checks between blocks is pending. all guest registers are in memory here.
+auto CPU::Recompiler::emitChain(Block* block) -> void {
+  vector<sljit_jump*> miss;
+  cmp64(field(self.clock), imm(Budget), set_sge);
+  miss.append(jump(flag_sge));
+  mov32_u8(reg(0), field(self.scc.cause.interruptPending));
+  mov32_u8(reg(1), field(self.scc.status.interruptMask));
+  test32(reg(0), reg(1), set_z);
+  miss.append(jump(flag_nz));
+  mov32_u8(reg(0), field(self.scc.nmiPending));
+  mov32_u8(reg(1), field(self.scc.sysadFrozen));
+  or32(reg(0), reg(0), reg(1), set_z);
+  miss.append(jump(flag_nz));
+  miss.append(cmp32_jump(field(self.context.segment[4]), imm(Context::Segment::Cached), flag_ne));
+
+  mov64(reg(0), field(self.ipu.pc));
+  mov64(reg(1), imm(sljit_sw(block)));
+  for(u32 index : range(2)) {
+    cmp64(reg(0), mem(reg(1), offsetof(Block, links) + index * sizeof(Link) + offsetof(Link, vaddr)), set_z);
+    auto next = jump(flag_nz);
+    mov64(reg(2), mem(reg(1), offsetof(Block, links) + index * sizeof(Link) + offsetof(Link, code)));
+    cmp64(reg(2), imm(0), set_z);
+    miss.append(jump(flag_z));
+    ijump(reg(2));
+    setLabel(next);
+  }
+
+  for(auto jump : miss) setLabel(jump);
+  mov64(field(exit), imm(sljit_sw(block)));
+  jumpEpilog();
+}
+
+auto CPU::Recompiler::emitLoad(u32 instruction, u32 size, bool sign, void (CPU::*function)(r64&, cr64&, s16)) -> void {
+  if(!inlineMemory || !Rtn) {
+    lea(reg(1), Rt);
+    lea(reg(2), Rs);
+    mov32(reg(3), imm(i16));
+    call(function);
+    return;
+  }
+
+  sync();
+  auto rs = src(Rsn);
+  auto rt = dst(Rtn, true);
+  auto miss = emitDataCache(rs, i16, size, false);
+  auto data = mem(reg(3), (u8*)&self.dcache.lines[0].bytes - (u8*)&self);
+  switch(size) {
+  case Byte: if(sign) mov64_s8(rt, data);  else mov64_u8(rt, data);  break;
+  case Half: if(sign) mov64_s16(rt, data); else mov64_u16(rt, data); break;
+  case Word: if(sign) mov64_s32(rt, data); else mov64_u32(rt, data); break;
+  case Dual:
+    mov64_u32(reg(0), data);
+    mov64_u32(reg(1), mem(reg(3), data.snd + 4));
+    shl64(reg(0), reg(0), imm(32));
+    or64(rt, reg(0), reg(1));
+    break;
+  }
+  add64(field(self.clock), field(self.clock), imm(1 * 2));
+  auto done = jump();
+
+  for(auto target : miss) setLabel(target);
+  lea(reg(1), Rt);
+  lea(reg(2), Rs);
+  mov32(reg(3), imm(i16));
+  fallback(function, Rtn);
+  setLabel(done);
+  inlined = 1;
+}
+
+auto CPU::Recompiler::emitStore(u32 instruction, u32 size, void (CPU::*function)(cr64&, cr64&, s16)) -> void {
+  if(!inlineMemory) {
+    lea(reg(1), Rt);
+    lea(reg(2), Rs);
+    mov32(reg(3), imm(i16));
+    call(function);
+    return;
+  }
+
+  sync();
+  auto rs = src(Rsn);
+  auto rt = size == Dual ? src(Rtn) : src32(Rtn);
+  auto miss = emitDataCache(rs, i16, size, true);
+  sljit_sw lines = (u8*)&self.dcache.lines[0] - (u8*)&self;
+  auto data = mem(reg(3), (u8*)&self.dcache.lines[0].bytes - (u8*)&self);
+  switch(size) {
+  case Byte: mov32_u8(data, rt); break;
+  case Half: mov32_u16(data, rt); break;
+  case Word: mov32(data, rt); break;
+  case Dual:
+    lshr64(reg(0), rt, imm(32));
+    mov32(data, reg(0));
+    mov32(mem(reg(3), data.snd + 4), rt);
+    break;
+  }
+  //line.dirty |= (1 << size) - 1 << (address & 15); line.dirtyPc = ipu.pc
+  and32(reg(1), reg(1), imm(15));
+  mov32(reg(0), imm((1 << size) - 1));
+  shl32(reg(0), reg(0), reg(1));
+  mov32_u16(reg(1), mem(reg(2), lines + offsetof(DataCache::Line, dirty)));
+  or32(reg(0), reg(0), reg(1));
+  mov32_u16(mem(reg(2), lines + offsetof(DataCache::Line, dirty)), reg(0));
+  mov64(reg(0), field(self.ipu.pc));
+  mov64(mem(reg(2), lines + offsetof(DataCache::Line, dirtyPc)), reg(0));
+  add64(field(self.clock), field(self.clock), imm(1 * 2));
+  auto done = jump();
+
+  for(auto target : miss) setLabel(target);
+  lea(reg(1), Rt);
+  lea(reg(2), Rs);
+  mov32(reg(3), imm(i16));
+  fallback(function, 0);
+  setLabel(done);
+  inlined = 1;
+}
+
 auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
   switch(instruction >> 26) {
 
@@ -107,104 +484,165 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //J n26
   case 0x02: {
-    mov32(reg(1), imm(n26));
-    call(&CPU::J);
+    if(!stepping) {
+      mov32(reg(1), imm(n26));
+      call(&CPU::J);
+      return 1;
+    }
+    sync();
+    mov64(reg(0), field(self.ipu.pc));
+    add64(reg(0), reg(0), imm(4));
+    and64(reg(0), reg(0), imm(0xffff'ffff'f000'0000ull));
+    or64(reg(0), reg(0), imm(n26 << 2));
+    emitTake(reg(0));
     return 1;
   }
 
   //JAL n26
   case 0x03: {
-    mov32(reg(1), imm(n26));
-    call(&CPU::JAL);
+    if(!stepping) {
+      mov32(reg(1), imm(n26));
+      call(&CPU::JAL);
+      return 1;
+    }
+    sync();
+    auto ra = dst(31);
+    mov64(reg(1), field(self.ipu.pc));
+    add64(ra, reg(1), imm(8));
+    add64(reg(1), reg(1), imm(4));
+    and64(reg(1), reg(1), imm(0xffff'ffff'f000'0000ull));
+    or64(reg(1), reg(1), imm(n26 << 2));
+    emitTake(reg(1));
     return 1;
   }
 
   //BEQ Rs,Rt,i16
   case 0x04: {
-    lea(reg(1), Rs);
-    lea(reg(2), Rt);
-    mov32(reg(3), imm(i16));
-    call(&CPU::BEQ);
+    sync();
+    cmp64(src(Rsn), src(Rtn), set_z);
+    emitBranch(flag_eq, i16, 0);
     return 1;
   }
 
   //BNE Rs,Rt,i16
   case 0x05: {
-    lea(reg(1), Rs);
-    lea(reg(2), Rt);
-    mov32(reg(3), imm(i16));
-    call(&CPU::BNE);
+    sync();
+    cmp64(src(Rsn), src(Rtn), set_z);
+    emitBranch(flag_ne, i16, 0);
     return 1;
   }
 
   //BLEZ Rs,i16
   case 0x06: {
-    lea(reg(1), Rs);
-    mov32(reg(2), imm(i16));
-    call(&CPU::BLEZ);
+    sync();
+    cmp64(src(Rsn), imm(0), set_sle);
+    emitBranch(flag_sle, i16, 0);
     return 1;
   }
 
   //BGTZ Rs,i16
   case 0x07: {
-    lea(reg(1), Rs);
-    mov32(reg(2), imm(i16));
-    call(&CPU::BGTZ);
+    sync();
+    cmp64(src(Rsn), imm(0), set_sgt);
+    emitBranch(flag_sgt, i16, 0);
     return 1;
   }
 
   //ADDI Rt,Rs,i16
   case 0x08: {
+    if(!Rtn) {
+      lea(reg(1), Rt);
+      lea(reg(2), Rs);
+      mov32(reg(3), imm(i16));
+      call(&CPU::ADDI);
+      return 0;
+    }
+    sync();
+    auto rs = src32(Rsn);
+    auto rt = dst(Rtn, true);
+    add32(reg(0), rs, imm(i16), set_o);
+    auto overflow = jump(flag_o);
+    mov64_s32(rt, reg(0));
+    auto done = jump();
+    setLabel(overflow);
     lea(reg(1), Rt);
     lea(reg(2), Rs);
     mov32(reg(3), imm(i16));
-    call(&CPU::ADDI);
+    fallback(&CPU::ADDI, Rtn);
+    setLabel(done);
+    inlined = 1;
     return 0;
   }
 
   //ADDIU Rt,Rs,i16
   case 0x09: {
-    add32(reg(0), mem(Rs32), imm(i16));
-    mov64_s32(reg(0), reg(0));
-    mov64(mem(Rt), reg(0));
+    if(Rtn) {
+      auto rs = src32(Rsn);
+      add32(reg(0), rs, imm(i16));
+      mov64_s32(dst(Rtn), reg(0));
+    }
+    inlined = 1;
     return 0;
   }
 
   //SLTI Rt,Rs,i16
   case 0x0a: {
-    cmp64(mem(Rs), imm(i16), set_slt);
-    mov64_f(mem(Rt), flag_slt);
+    if(Rtn) {
+      auto rs = src(Rsn);
+      auto rt = dst(Rtn);
+      cmp64(rs, imm(i16), set_slt);
+      mov64_f(rt, flag_slt);
+    }
+    inlined = 1;
     return 0;
   }
 
   //SLTIU Rt,Rs,i16
   case 0x0b: {
-    cmp64(mem(Rs), imm(i16), set_ult);
-    mov64_f(mem(Rt), flag_ult);
+    if(Rtn) {
+      auto rs = src(Rsn);
+      auto rt = dst(Rtn);
+      cmp64(rs, imm(i16), set_ult);
+      mov64_f(rt, flag_ult);
+    }
+    inlined = 1;
     return 0;
   }
 
   //ANDI Rt,Rs,n16
   case 0x0c: {
-    and64(mem(Rt), mem(Rs), imm(n16));
+    if(Rtn) {
+      auto rs = src(Rsn);
+      and64(dst(Rtn), rs, imm(n16));
+    }
+    inlined = 1;
     return 0;
   }
 
   //ORI Rt,Rs,n16
   case 0x0d: {
-    or64(mem(Rt), mem(Rs), imm(n16));
+    if(Rtn) {
+      auto rs = src(Rsn);
+      or64(dst(Rtn), rs, imm(n16));
+    }
+    inlined = 1;
     return 0;
   }
 
   //XORI Rt,Rs,n16
   case 0x0e: {
-    xor64(mem(Rt), mem(Rs), imm(n16));
+    if(Rtn) {
+      auto rs = src(Rsn);
+      xor64(dst(Rtn), rs, imm(n16));
+    }
+    inlined = 1;
     return 0;
   }
 
   //LUI Rt,n16
   case 0x0f: {
-    mov64(mem(Rt), imm(s32(n16 << 16)));
+    if(Rtn) mov64(dst(Rtn), imm(s32(n16 << 16)));
+    inlined = 1;
     return 0;
   }
 
@@ -231,35 +669,33 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //BEQL Rs,Rt,i16
   case 0x14: {
-    lea(reg(1), Rs);
-    lea(reg(2), Rt);
-    mov32(reg(3), imm(i16));
-    call(&CPU::BEQL);
+    sync();
+    cmp64(src(Rsn), src(Rtn), set_z);
+    emitBranch(flag_eq, i16, 1);
     return 1;
   }
 
   //BNEL Rs,Rt,i16
   case 0x15: {
-    lea(reg(1), Rs);
-    lea(reg(2), Rt);
-    mov32(reg(3), imm(i16));
-    call(&CPU::BNEL);
+    sync();
+    cmp64(src(Rsn), src(Rtn), set_z);
+    emitBranch(flag_ne, i16, 1);
     return 1;
   }
 
   //BLEZL Rs,i16
   case 0x16: {
-    lea(reg(1), Rs);
-    mov32(reg(2), imm(i16));
-    call(&CPU::BLEZL);
+    sync();
+    cmp64(src(Rsn), imm(0), set_sle);
+    emitBranch(flag_sle, i16, 1);
     return 1;
   }
 
   //BGTZL Rs,i16
   case 0x17: {
-    lea(reg(1), Rs);
-    mov32(reg(2), imm(i16));
-    call(&CPU::BGTZL);
+    sync();
+    cmp64(src(Rsn), imm(0), set_sgt);
+    emitBranch(flag_sgt, i16, 1);
     return 1;
   }
 
@@ -274,10 +710,26 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //DADDIU Rt,Rs,i16
   case 0x19: {
+    if(!Rtn) {
+      lea(reg(1), Rt);
+      lea(reg(2), Rs);
+      mov32(reg(3), imm(i16));
+      call(&CPU::DADDIU);
+      return 0;
+    }
+    sync();
+    auto rs = src(Rsn);
+    auto rt = dst(Rtn, true);
+    auto reserved = emitReserved();
+    add64(rt, rs, imm(i16));
+    auto done = jump();
+    setLabel(reserved);
     lea(reg(1), Rt);
     lea(reg(2), Rs);
     mov32(reg(3), imm(i16));
-    call(&CPU::DADDIU);
+    fallback(&CPU::DADDIU, Rtn);
+    setLabel(done);
+    inlined = 1;
     return 0;
   }
 
@@ -307,19 +759,13 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //LB Rt,Rs,i16
   case 0x20: {
-    lea(reg(1), Rt);
-    lea(reg(2), Rs);
-    mov32(reg(3), imm(i16));
-    call(&CPU::LB);
+    emitLoad(instruction, Byte, 1, &CPU::LB);
     return 0;
   }
 
   //LH Rt,Rs,i16
   case 0x21: {
-    lea(reg(1), Rt);
-    lea(reg(2), Rs);
-    mov32(reg(3), imm(i16));
-    call(&CPU::LH);
+    emitLoad(instruction, Half, 1, &CPU::LH);
     return 0;
   }
 
@@ -334,28 +780,19 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //LW Rt,Rs,i16
   case 0x23: {
-    lea(reg(1), Rt);
-    lea(reg(2), Rs);
-    mov32(reg(3), imm(i16));
-    call(&CPU::LW);
+    emitLoad(instruction, Word, 1, &CPU::LW);
     return 0;
   }
 
   //LBU Rt,Rs,i16
   case 0x24: {
-    lea(reg(1), Rt);
-    lea(reg(2), Rs);
-    mov32(reg(3), imm(i16));
-    call(&CPU::LBU);
+    emitLoad(instruction, Byte, 0, &CPU::LBU);
     return 0;
   }
 
   //LHU Rt,Rs,i16
   case 0x25: {
-    lea(reg(1), Rt);
-    lea(reg(2), Rs);
-    mov32(reg(3), imm(i16));
-    call(&CPU::LHU);
+    emitLoad(instruction, Half, 0, &CPU::LHU);
     return 0;
   }
 
@@ -370,28 +807,19 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //LWU Rt,Rs,i16
   case 0x27: {
-    lea(reg(1), Rt);
-    lea(reg(2), Rs);
-    mov32(reg(3), imm(i16));
-    call(&CPU::LWU);
+    emitLoad(instruction, Word, 0, &CPU::LWU);
     return 0;
   }
 
   //SB Rt,Rs,i16
   case 0x28: {
-    lea(reg(1), Rt);
-    lea(reg(2), Rs);
-    mov32(reg(3), imm(i16));
-    call(&CPU::SB);
+    emitStore(instruction, Byte, &CPU::SB);
     return 0;
   }
 
   //SH Rt,Rs,i16
   case 0x29: {
-    lea(reg(1), Rt);
-    lea(reg(2), Rs);
-    mov32(reg(3), imm(i16));
-    call(&CPU::SH);
+    emitStore(instruction, Half, &CPU::SH);
     return 0;
   }
 
@@ -406,10 +834,7 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //SW Rt,Rs,i16
   case 0x2b: {
-    lea(reg(1), Rt);
-    lea(reg(2), Rs);
-    mov32(reg(3), imm(i16));
-    call(&CPU::SW);
+    emitStore(instruction, Word, &CPU::SW);
     return 0;
   }
 
@@ -505,10 +930,7 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //LD Rt,Rs,i16
   case 0x37: {
-    lea(reg(1), Rt);
-    lea(reg(2), Rs);
-    mov32(reg(3), imm(i16));
-    call(&CPU::LD);
+    emitLoad(instruction, Dual, 0, &CPU::LD);
     return 0;
   }
 
@@ -568,10 +990,7 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //SD Rt,Rs,i16
   case 0x3f: {
-    lea(reg(1), Rt);
-    lea(reg(2), Rs);
-    mov32(reg(3), imm(i16));
-    call(&CPU::SD);
+    emitStore(instruction, Dual, &CPU::SD);
     return 0;
   }
 
@@ -585,9 +1004,12 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //SLL Rd,Rt,Sa
   case 0x00: {
-    shl32(reg(0), mem(Rt32), imm(Sa));
-    mov64_s32(reg(0), reg(0));
-    mov64(mem(Rd), reg(0));
+    if(Rdn) {
+      auto rt = src32(Rtn);
+      shl32(reg(0), rt, imm(Sa));
+      mov64_s32(dst(Rdn), reg(0));
+    }
+    inlined = 1;
     return 0;
   }
 
@@ -599,25 +1021,35 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //SRL Rd,Rt,Sa
   case 0x02: {
-    lshr32(reg(0), mem(Rt32), imm(Sa));
-    mov64_s32(reg(0), reg(0));
-    mov64(mem(Rd), reg(0));
+    if(Rdn) {
+      auto rt = src32(Rtn);
+      lshr32(reg(0), rt, imm(Sa));
+      mov64_s32(dst(Rdn), reg(0));
+    }
+    inlined = 1;
     return 0;
   }
 
   //SRA Rd,Rt,Sa
   case 0x03: {
-    ashr64(reg(0), mem(Rt), imm(Sa));
-    mov64_s32(reg(0), reg(0));
-    mov64(mem(Rd), reg(0));
+    if(Rdn) {
+      auto rt = src(Rtn);
+      ashr64(reg(0), rt, imm(Sa));
+      mov64_s32(dst(Rdn), reg(0));
+    }
+    inlined = 1;
     return 0;
   }
 
   //SLLV Rd,Rt,Rs
   case 0x04: {
-    mshl32(reg(0), mem(Rt32), mem(Rs32));
-    mov64_s32(reg(0), reg(0));
-    mov64(mem(Rd), reg(0));
+    if(Rdn) {
+      auto rt = src32(Rtn);
+      auto rs = src32(Rsn);
+      mshl32(reg(0), rt, rs);
+      mov64_s32(dst(Rdn), reg(0));
+    }
+    inlined = 1;
     return 0;
   }
 
@@ -629,33 +1061,57 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //SRLV Rd,Rt,RS
   case 0x06: {
-    mlshr32(reg(0), mem(Rt32), mem(Rs32));
-    mov64_s32(reg(0), reg(0));
-    mov64(mem(Rd), reg(0));
+    if(Rdn) {
+      auto rt = src32(Rtn);
+      auto rs = src32(Rsn);
+      mlshr32(reg(0), rt, rs);
+      mov64_s32(dst(Rdn), reg(0));
+    }
+    inlined = 1;
     return 0;
   }
 
   //SRAV Rd,Rt,Rs
   case 0x07: {
-    and64(reg(1), mem(Rs), imm(31));
-    ashr64(reg(0), mem(Rt), reg(1));
-    mov64_s32(reg(0), reg(0));
-    mov64(mem(Rd), reg(0));
+    if(Rdn) {
+      auto rt = src(Rtn);
+      auto rs = src(Rsn);
+      and64(reg(1), rs, imm(31));
+      ashr64(reg(0), rt, reg(1));
+      mov64_s32(dst(Rdn), reg(0));
+    }
+    inlined = 1;
     return 0;
   }
 
   //JR Rs
   case 0x08: {
-    lea(reg(1), Rs);
-    call(&CPU::JR);
+    if(!stepping) {
+      lea(reg(1), Rs);
+      call(&CPU::JR);
+      return 1;
+    }
+    sync();
+    emitTake(src(Rsn));
     return 1;
   }
 
   //JALR Rd,Rs
   case 0x09: {
-    lea(reg(1), Rd);
-    lea(reg(2), Rs);
-    call(&CPU::JALR);
+    if(!stepping) {
+      lea(reg(1), Rd);
+      lea(reg(2), Rs);
+      call(&CPU::JALR);
+      return 1;
+    }
+    sync();
+    mov64(reg(1), src(Rsn));
+    if(Rdn) {
+      auto rd = dst(Rdn);
+      mov64(reg(0), field(self.ipu.pc));
+      add64(rd, reg(0), imm(8));
+    }
+    emitTake(reg(1));
     return 1;
   }
 
@@ -691,25 +1147,29 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //MFHI Rd
   case 0x10: {
-    mov64(mem(Rd), mem(Hi));
+    if(Rdn) mov64(dst(Rdn), mem(Hi));
+    inlined = 1;
     return 0;
   }
 
   //MTHI Rs
   case 0x11: {
-    mov64(mem(Hi), mem(Rs));
+    mov64(mem(Hi), src(Rsn));
+    inlined = 1;
     return 0;
   }
 
   //MFLO Rd
   case 0x12: {
-    mov64(mem(Rd), mem(Lo));
+    if(Rdn) mov64(dst(Rdn), mem(Lo));
+    inlined = 1;
     return 0;
   }
 
   //MTLO Rs
   case 0x13: {
-    mov64(mem(Lo), mem(Rs));
+    mov64(mem(Lo), src(Rsn));
+    inlined = 1;
     return 0;
   }
 
@@ -812,61 +1272,124 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //ADD Rd,Rs,Rt
   case 0x20: {
+    if(!Rdn) {
+      lea(reg(1), Rd);
+      lea(reg(2), Rs);
+      lea(reg(3), Rt);
+      call(&CPU::ADD);
+      return 0;
+    }
+    sync();
+    auto rs = src32(Rsn);
+    auto rt = src32(Rtn);
+    auto rd = dst(Rdn, true);
+    add32(reg(0), rs, rt, set_o);
+    auto overflow = jump(flag_o);
+    mov64_s32(rd, reg(0));
+    auto done = jump();
+    setLabel(overflow);
     lea(reg(1), Rd);
     lea(reg(2), Rs);
     lea(reg(3), Rt);
-    call(&CPU::ADD);
+    fallback(&CPU::ADD, Rdn);
+    setLabel(done);
+    inlined = 1;
     return 0;
   }
 
   //ADDU Rd,Rs,Rt
   case 0x21: {
-    add32(reg(0), mem(Rs32), mem(Rt32));
-    mov64_s32(reg(0), reg(0));
-    mov64(mem(Rd), reg(0));
+    if(Rdn) {
+      auto rs = src32(Rsn);
+      auto rt = src32(Rtn);
+      add32(reg(0), rs, rt);
+      mov64_s32(dst(Rdn), reg(0));
+    }
+    inlined = 1;
     return 0;
   }
 
   //SUB Rd,Rs,Rt
   case 0x22: {
+    if(!Rdn) {
+      lea(reg(1), Rd);
+      lea(reg(2), Rs);
+      lea(reg(3), Rt);
+      call(&CPU::SUB);
+      return 0;
+    }
+    sync();
+    auto rs = src32(Rsn);
+    auto rt = src32(Rtn);
+    auto rd = dst(Rdn, true);
+    sub32(reg(0), rs, rt, set_o);
+    auto overflow = jump(flag_o);
+    mov64_s32(rd, reg(0));
+    auto done = jump();
+    setLabel(overflow);
     lea(reg(1), Rd);
     lea(reg(2), Rs);
     lea(reg(3), Rt);
-    call(&CPU::SUB);
+    fallback(&CPU::SUB, Rdn);
+    setLabel(done);
+    inlined = 1;
     return 0;
   }
 
   //SUBU Rd,Rs,Rt
   case 0x23: {
-    sub32(reg(0), mem(Rs32), mem(Rt32));
-    mov64_s32(reg(0), reg(0));
-    mov64(mem(Rd), reg(0));
+    if(Rdn) {
+      auto rs = src32(Rsn);
+      auto rt = src32(Rtn);
+      sub32(reg(0), rs, rt);
+      mov64_s32(dst(Rdn), reg(0));
+    }
+    inlined = 1;
     return 0;
   }
 
   //AND Rd,Rs,Rt
   case 0x24: {
-    and64(mem(Rd), mem(Rs), mem(Rt));
+    if(Rdn) {
+      auto rs = src(Rsn);
+      auto rt = src(Rtn);
+      and64(dst(Rdn), rs, rt);
+    }
+    inlined = 1;
     return 0;
   }
 
   //OR Rd,Rs,Rt
   case 0x25: {
-    or64(mem(Rd), mem(Rs), mem(Rt));
+    if(Rdn) {
+      auto rs = src(Rsn);
+      auto rt = src(Rtn);
+      or64(dst(Rdn), rs, rt);
+    }
+    inlined = 1;
     return 0;
   }
 
   //XOR Rd,Rs,Rt
   case 0x26: {
-    xor64(mem(Rd), mem(Rs), mem(Rt));
+    if(Rdn) {
+      auto rs = src(Rsn);
+      auto rt = src(Rtn);
+      xor64(dst(Rdn), rs, rt);
+    }
+    inlined = 1;
     return 0;
   }
 
   //NOR Rd,Rs,Rt
   case 0x27: {
-    or64(reg(0), mem(Rs), mem(Rt));
-    xor64(reg(0), reg(0), imm(-1));
-    mov64(mem(Rd), reg(0));
+    if(Rdn) {
+      auto rs = src(Rsn);
+      auto rt = src(Rtn);
+      or64(reg(0), rs, rt);
+      xor64(dst(Rdn), reg(0), imm(-1));
+    }
+    inlined = 1;
     return 0;
   }
 
@@ -878,15 +1401,27 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //SLT Rd,Rs,Rt
   case 0x2a: {
-    cmp64(mem(Rs), mem(Rt), set_slt);
-    mov64_f(mem(Rd), flag_slt);
+    if(Rdn) {
+      auto rs = src(Rsn);
+      auto rt = src(Rtn);
+      auto rd = dst(Rdn);
+      cmp64(rs, rt, set_slt);
+      mov64_f(rd, flag_slt);
+    }
+    inlined = 1;
     return 0;
   }
 
   //SLTU Rd,Rs,Rt
   case 0x2b: {
-    cmp64(mem(Rs), mem(Rt), set_ult);
-    mov64_f(mem(Rd), flag_ult);
+    if(Rdn) {
+      auto rs = src(Rsn);
+      auto rt = src(Rtn);
+      auto rd = dst(Rdn);
+      cmp64(rs, rt, set_ult);
+      mov64_f(rd, flag_ult);
+    }
+    inlined = 1;
     return 0;
   }
 
@@ -901,10 +1436,27 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //DADDU Rd,Rs,Rt
   case 0x2d: {
+    if(!Rdn) {
+      lea(reg(1), Rd);
+      lea(reg(2), Rs);
+      lea(reg(3), Rt);
+      call(&CPU::DADDU);
+      return 0;
+    }
+    sync();
+    auto rs = src(Rsn);
+    auto rt = src(Rtn);
+    auto rd = dst(Rdn, true);
+    auto reserved = emitReserved();
+    add64(rd, rs, rt);
+    auto done = jump();
+    setLabel(reserved);
     lea(reg(1), Rd);
     lea(reg(2), Rs);
     lea(reg(3), Rt);
-    call(&CPU::DADDU);
+    fallback(&CPU::DADDU, Rdn);
+    setLabel(done);
+    inlined = 1;
     return 0;
   }
 
@@ -919,10 +1471,27 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //DSUBU Rd,Rs,Rt
   case 0x2f: {
+    if(!Rdn) {
+      lea(reg(1), Rd);
+      lea(reg(2), Rs);
+      lea(reg(3), Rt);
+      call(&CPU::DSUBU);
+      return 0;
+    }
+    sync();
+    auto rs = src(Rsn);
+    auto rt = src(Rtn);
+    auto rd = dst(Rdn, true);
+    auto reserved = emitReserved();
+    sub64(rd, rs, rt);
+    auto done = jump();
+    setLabel(reserved);
     lea(reg(1), Rd);
     lea(reg(2), Rs);
     lea(reg(3), Rt);
-    call(&CPU::DSUBU);
+    fallback(&CPU::DSUBU, Rdn);
+    setLabel(done);
+    inlined = 1;
     return 0;
   }
 
@@ -988,10 +1557,26 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //DSLL Rd,Rt,Sa
   case 0x38: {
+    if(!Rdn) {
+      lea(reg(1), Rd);
+      lea(reg(2), Rt);
+      mov32(reg(3), imm(Sa));
+      call(&CPU::DSLL);
+      return 0;
+    }
+    sync();
+    auto rt = src(Rtn);
+    auto rd = dst(Rdn, true);
+    auto reserved = emitReserved();
+    shl64(rd, rt, imm(Sa));
+    auto done = jump();
+    setLabel(reserved);
     lea(reg(1), Rd);
     lea(reg(2), Rt);
     mov32(reg(3), imm(Sa));
-    call(&CPU::DSLL);
+    fallback(&CPU::DSLL, Rdn);
+    setLabel(done);
+    inlined = 1;
     return 0;
   }
 
@@ -1003,28 +1588,76 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //DSRL Rd,Rt,Sa
   case 0x3a: {
+    if(!Rdn) {
+      lea(reg(1), Rd);
+      lea(reg(2), Rt);
+      mov32(reg(3), imm(Sa));
+      call(&CPU::DSRL);
+      return 0;
+    }
+    sync();
+    auto rt = src(Rtn);
+    auto rd = dst(Rdn, true);
+    auto reserved = emitReserved();
+    lshr64(rd, rt, imm(Sa));
+    auto done = jump();
+    setLabel(reserved);
     lea(reg(1), Rd);
     lea(reg(2), Rt);
     mov32(reg(3), imm(Sa));
-    call(&CPU::DSRL);
+    fallback(&CPU::DSRL, Rdn);
+    setLabel(done);
+    inlined = 1;
     return 0;
   }
 
   //DSRA Rd,Rt,Sa
   case 0x3b: {
+    if(!Rdn) {
+      lea(reg(1), Rd);
+      lea(reg(2), Rt);
+      mov32(reg(3), imm(Sa));
+      call(&CPU::DSRA);
+      return 0;
+    }
+    sync();
+    auto rt = src(Rtn);
+    auto rd = dst(Rdn, true);
+    auto reserved = emitReserved();
+    ashr64(rd, rt, imm(Sa));
+    auto done = jump();
+    setLabel(reserved);
     lea(reg(1), Rd);
     lea(reg(2), Rt);
     mov32(reg(3), imm(Sa));
-    call(&CPU::DSRA);
+    fallback(&CPU::DSRA, Rdn);
+    setLabel(done);
+    inlined = 1;
     return 0;
   }
 
   //DSLL32 Rd,Rt,Sa
   case 0x3c: {
+    if(!Rdn) {
+      lea(reg(1), Rd);
+      lea(reg(2), Rt);
+      mov32(reg(3), imm(Sa+32));
+      call(&CPU::DSLL);
+      return 0;
+    }
+    sync();
+    auto rt = src(Rtn);
+    auto rd = dst(Rdn, true);
+    auto reserved = emitReserved();
+    shl64(rd, rt, imm(Sa+32));
+    auto done = jump();
+    setLabel(reserved);
     lea(reg(1), Rd);
     lea(reg(2), Rt);
     mov32(reg(3), imm(Sa+32));
-    call(&CPU::DSLL);
+    fallback(&CPU::DSLL, Rdn);
+    setLabel(done);
+    inlined = 1;
     return 0;
   }
 
@@ -1036,19 +1669,51 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //DSRL32 Rd,Rt,Sa
   case 0x3e: {
+    if(!Rdn) {
+      lea(reg(1), Rd);
+      lea(reg(2), Rt);
+      mov32(reg(3), imm(Sa+32));
+      call(&CPU::DSRL);
+      return 0;
+    }
+    sync();
+    auto rt = src(Rtn);
+    auto rd = dst(Rdn, true);
+    auto reserved = emitReserved();
+    lshr64(rd, rt, imm(Sa+32));
+    auto done = jump();
+    setLabel(reserved);
     lea(reg(1), Rd);
     lea(reg(2), Rt);
     mov32(reg(3), imm(Sa+32));
-    call(&CPU::DSRL);
+    fallback(&CPU::DSRL, Rdn);
+    setLabel(done);
+    inlined = 1;
     return 0;
   }
 
   //DSRA32 Rd,Rt,Sa
   case 0x3f: {
+    if(!Rdn) {
+      lea(reg(1), Rd);
+      lea(reg(2), Rt);
+      mov32(reg(3), imm(Sa+32));
+      call(&CPU::DSRA);
+      return 0;
+    }
+    sync();
+    auto rt = src(Rtn);
+    auto rd = dst(Rdn, true);
+    auto reserved = emitReserved();
+    ashr64(rd, rt, imm(Sa+32));
+    auto done = jump();
+    setLabel(reserved);
     lea(reg(1), Rd);
     lea(reg(2), Rt);
     mov32(reg(3), imm(Sa+32));
-    call(&CPU::DSRA);
+    fallback(&CPU::DSRA, Rdn);
+    setLabel(done);
+    inlined = 1;
     return 0;
   }
 
@@ -1062,33 +1727,33 @@ auto CPU::Recompiler::emitREGIMM(u32 instruction) -> bool {
 
   //BLTZ Rs,i16
   case 0x00: {
-    lea(reg(1), Rs);
-    mov32(reg(2), imm(i16));
-    call(&CPU::BLTZ);
+    sync();
+    cmp64(src(Rsn), imm(0), set_slt);
+    emitBranch(flag_slt, i16, 0);
     return 0;
   }
 
   //BGEZ Rs,i16
   case 0x01: {
-    lea(reg(1), Rs);
-    mov32(reg(2), imm(i16));
-    call(&CPU::BGEZ);
+    sync();
+    cmp64(src(Rsn), imm(0), set_sge);
+    emitBranch(flag_sge, i16, 0);
     return 0;
   }
 
   //BLTZL Rs,i16
   case 0x02: {
-    lea(reg(1), Rs);
-    mov32(reg(2), imm(i16));
-    call(&CPU::BLTZL);
+    sync();
+    cmp64(src(Rsn), imm(0), set_slt);
+    emitBranch(flag_slt, i16, 1);
     return 0;
   }
 
   //BGEZL Rs,i16
   case 0x03: {
-    lea(reg(1), Rs);
-    mov32(reg(2), imm(i16));
-    call(&CPU::BGEZL);
+    sync();
+    cmp64(src(Rsn), imm(0), set_sge);
+    emitBranch(flag_sge, i16, 1);
     return 0;
   }
 
@@ -1160,33 +1825,55 @@ auto CPU::Recompiler::emitREGIMM(u32 instruction) -> bool {
 
   //BLTZAL Rs,i16
   case 0x10: {
-    lea(reg(1), Rs);
-    mov32(reg(2), imm(i16));
-    call(&CPU::BLTZAL);
+    sync();
+    auto ra = dst(31);
+    mov64(reg(0), field(self.ipu.pc));
+    add32(reg(0), reg(0), imm(8));
+    mov64_s32(ra, reg(0));
+    cmp64(src(Rsn), imm(0), set_slt);
+    emitBranch(flag_slt, i16, 0);
     return 0;
   }
 
   //BGEZAL Rs,i16
   case 0x11: {
-    lea(reg(1), Rs);
-    mov32(reg(2), imm(i16));
-    call(&CPU::BGEZAL);
+    if(!stepping) {
+      lea(reg(1), Rs);
+      mov32(reg(2), imm(i16));
+      call(&CPU::BGEZAL);
+      return 0;
+    }
+    sync();
+    cmp64(src(Rsn), imm(0), set_sge);
+    emitBranch(flag_sge, i16, 0);
+    auto ra = dst(31);
+    mov64(reg(0), field(self.ipu.pc));
+    add32(reg(0), reg(0), imm(8));
+    mov64_s32(ra, reg(0));
     return 0;
   }
 
   //BLTZALL Rs,i16
   case 0x12: {
-    lea(reg(1), Rs);
-    mov32(reg(2), imm(i16));
-    call(&CPU::BLTZALL);
+    sync();
+    auto ra = dst(31);
+    mov64(reg(0), field(self.ipu.pc));
+    add32(reg(0), reg(0), imm(8));
+    mov64_s32(ra, reg(0));
+    cmp64(src(Rsn), imm(0), set_slt);
+    emitBranch(flag_slt, i16, 1);
     return 0;
   }
 
   //BGEZALL Rs,i16
   case 0x13: {
-    lea(reg(1), Rs);
-    mov32(reg(2), imm(i16));
-    call(&CPU::BGEZALL);
+    sync();
+    cmp64(src(Rsn), imm(0), set_sge);
+    emitBranch(flag_sge, i16, 1);
+    auto ra = dst(31);
+    mov64(reg(0), field(self.ipu.pc));
+    add32(reg(0), reg(0), imm(8));
+    mov64_s32(ra, reg(0));
     return 0;
   }
 
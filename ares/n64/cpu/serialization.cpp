@@ -142,6 +142,7 @@ auto CPU::serialize(serializer& s) -> void {
 
   s(cop2.latch);
 
+  tlb.flush();
   if constexpr(Accuracy::CPU::Recompiler) {
     recompiler.reset();
   }
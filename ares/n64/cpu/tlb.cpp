@@ -13,11 +13,18 @@ auto CPU::TLB::load(u64 vaddr, const Entry& entry, bool noExceptions) -> maybe<M
     return Match{false};
   }
   physicalAddress = entry.physicalAddress[lo] + (vaddr & entry.addressMaskLo);
+  fill(vaddr, entry, lo);
   self.debugger.tlbLoad(vaddr, physicalAddress);
   return Match{true, entry.cacheAlgorithm[lo] != 2, physicalAddress};
 }
 
 auto CPU::TLB::load(u64 vaddr, bool noExceptions) -> Match {
+  if(auto page = lookup(vaddr)) {
+    physicalAddress = page & ~0xfff | vaddr & 0xfff;
+    self.debugger.tlbLoad(vaddr, physicalAddress);
+    return {true, bool(page & Pages::Cached), physicalAddress};
+  }
+
   for(auto& entry : this->tlbCache.entry) {
     if(!entry.entry) continue;
     if(auto match = load(vaddr, *entry.entry, noExceptions)) {
@@ -44,6 +51,11 @@ auto CPU::TLB::load(u64 vaddr, bool noExceptions) -> Match {
 // Fast(er) version of load for recompiler icache lookups
 // avoids exceptions/debug checks
 auto CPU::TLB::loadFast(u64 vaddr) -> Match {
+  if(auto page = lookup(vaddr)) {
+    physicalAddress = page & ~0xfff | vaddr & 0xfff;
+    return {true, bool(page & Pages::Cached), physicalAddress};
+  }
+
   for(auto& entry : this->entry) {
     if(!entry.globals && entry.addressSpaceID != self.scc.tlb.addressSpaceID) continue;
     if((vaddr & entry.addressMaskHi) != entry.virtualAddress) continue;
@@ -75,11 +87,18 @@ auto CPU::TLB::store(u64 vaddr, const Entry& entry) -> maybe<Match> {
     return Match{false};
   }
   physicalAddress = entry.physicalAddress[lo] + (vaddr & entry.addressMaskLo);
+  fill(vaddr, entry, lo);
   self.debugger.tlbStore(vaddr, physicalAddress);
   return Match{true, entry.cacheAlgorithm[lo] != 2, physicalAddress};
 }
 
 auto CPU::TLB::store(u64 vaddr) -> Match {
+  if(auto page = lookup(vaddr); page & Pages::Dirty) {
+    physicalAddress = page & ~0xfff | vaddr & 0xfff;
+    self.debugger.tlbStore(vaddr, physicalAddress);
+    return {true, bool(page & Pages::Cached), physicalAddress};
+  }
+
   for(auto& entry : this->tlbCache.entry) {
     if(!entry.entry) continue;
     if(auto match = store(vaddr, *entry.entry)) {
@@ -101,6 +120,27 @@ auto CPU::TLB::store(u64 vaddr) -> Match {
   return {false};
 }
 
+//pages are at least 4KiB, so a match holds for every address in the same 4KiB page
+//until the entries or the address space ID change
+auto CPU::TLB::lookup(u64 vaddr) const -> u32 {
+  if((s32)vaddr != vaddr) return 0;
+  return pages.lookup[u32(vaddr) >> 12];
+}
+
+auto CPU::TLB::fill(u64 vaddr, const Entry& entry, bool lo) -> void {
+  if((s32)vaddr != vaddr) return;
+  u32 page = u32(vaddr) >> 12;
+  if(!pages.lookup[page]) pages.filled.append(page);
+  pages.lookup[page] = physicalAddress & ~0xfff | Pages::Valid;
+  if(entry.dirty[lo]) pages.lookup[page] |= Pages::Dirty;
+  if(entry.cacheAlgorithm[lo] != 2) pages.lookup[page] |= Pages::Cached;
+}
+
+auto CPU::TLB::flush() -> void {
+  for(auto page : pages.filled) pages.lookup[page] = 0;
+  pages.filled.resize(0);
+}
+
 auto CPU::TLB::Entry::synchronize() -> void {
   pageMask = pageMask & (0b101010101010 << 13);
   pageMask |= pageMask >> 1;
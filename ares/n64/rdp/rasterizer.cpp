@@ -0,0 +1,788 @@
+//software renderer
+
+auto RDP::Rasterizer::power() -> void {
+  kill();
+  discard();
+  current = {};
+  texture = {};
+  quit = false;
+  threads = 0;
+  #if defined(VULKAN)
+  if(vulkan.enable) return;
+  #endif
+  if constexpr(Accuracy::RDP::Threaded) {
+    //the emulation thread draws the first band itself while it waits for the others
+    u32 processors = std::thread::hardware_concurrency();
+    threads = min(processors ? processors - 1 : 0, Workers);
+  }
+  for(u32 index : range(threads)) {
+    workers[index] = thread::create({&RDP::Rasterizer::main, this}, 1 + index);
+  }
+}
+
+auto RDP::Rasterizer::kill() -> void {
+  if(!threads) return;
+  lock.lock();
+  quit = true;
+  generation++;
+  lock.unlock();
+  wake.notify_all();
+  for(u32 index : range(threads)) workers[index].join();
+  threads = 0;
+}
+
+auto RDP::Rasterizer::main(uintptr band) -> void {
+  u32 seen = 0;
+  while(true) {
+    unique_lock<mutex> guard(lock);
+    wake.wait(guard, [&] { return generation != seen; });
+    seen = generation;
+    if(quit) return;
+    guard.unlock();
+    execute(band);
+    guard.lock();
+    if(--running == 0) done.notify_one();
+  }
+}
+
+//draws every recorded primitive; called at Sync_Full, and whenever RDRAM they may write is about to be read
+auto RDP::Rasterizer::flush() -> void {
+  if(!primitives) return;
+  if(threads) {
+    lock.lock();
+    running = threads;
+    generation++;
+    lock.unlock();
+    wake.notify_all();
+  }
+  execute(0);
+  if(threads) {
+    unique_lock<mutex> guard(lock);
+    done.wait(guard, [&] { return running == 0; });
+  }
+  discard();
+}
+
+auto RDP::Rasterizer::discard() -> void {
+  primitives.resize(0);
+  states.resize(0);
+  tmems.resize(0);
+  written.resize(0);
+  stateChanged = true;
+  tmemChanged = true;
+}
+
+auto RDP::Rasterizer::update() -> State& {
+  stateChanged = true;
+  return current;
+}
+
+auto RDP::Rasterizer::tmem() -> TMEM& {
+  tmemChanged = true;
+  return texture;
+}
+
+auto RDP::Rasterizer::submit(Primitive& primitive) -> void {
+  if(primitive.y0 >= primitive.y1) return;
+  if(stateChanged) states.append(current), stateChanged = false;
+  if(tmemChanged) tmems.append(texture), tmemChanged = false;
+  primitive.state = states.size() - 1;
+  primitive.tmem = tmems.size() - 1;
+  primitives.append(primitive);
+
+  //remember which RDRAM this primitive may write, so that loads from it draw the pending primitives first
+  u32 width = current.color.width + 1;
+  u32 size = current.color.size == 3 ? 4 : current.color.size == 2 ? 2 : 1;
+  vector<Range> ranges;
+  ranges.append({current.color.dramAddress + primitive.y0 * width * size, current.color.dramAddress + primitive.y1 * width * size});
+  if(current.other.zUpdate && primitive.flags & Primitive::Depth) {
+    ranges.append({current.mask.dramAddress + primitive.y0 * width * 2, current.mask.dramAddress + primitive.y1 * width * 2});
+  }
+  for(auto range : ranges) {
+    bool merged = false;
+    for(auto& other : written) {
+      if(range.lo > other.hi || range.hi < other.lo) continue;
+      other.lo = min(other.lo, range.lo);
+      other.hi = max(other.hi, range.hi);
+      merged = true;
+      break;
+    }
+    if(!merged) written.append(range);
+  }
+  if(written.size() > 16) {
+    Range range = written[0];
+    for(auto& other : written) range.lo = min(range.lo, other.lo), range.hi = max(range.hi, other.hi);
+    written.resize(0);
+    written.append(range);
+  }
+
+  if(primitives.size() >= Limit) flush();
+}
+
+auto RDP::Rasterizer::hazard(u32 address, u32 length) -> void {
+  for(auto& range : written) {
+    if(address < range.hi && address + length > range.lo) return flush();
+  }
+}
+
+//0x08-0x0f: the edge, shade, texture and depth coefficients are converted to 16.16 fixed point
+auto RDP::Rasterizer::triangle(u32 flags) -> void {
+  auto fixed = [](const Point& point) -> s32 { return s32(u32(point.i) << 16 | u32(point.f)); };
+
+  auto& edge = self.edge;
+  Primitive primitive{};
+  primitive.type = Primitive::Triangle;
+  primitive.flags = flags;
+  primitive.tile = edge.tile;
+  auto& t = primitive.triangle;
+  t.yh = sclip<14>(edge.y.hi);
+  t.ym = sclip<14>(edge.y.md);
+  t.yl = sclip<14>(edge.y.lo);
+  t.xh = fixed(edge.x.hi.c), t.dxh = fixed(edge.x.hi.s);
+  t.xm = fixed(edge.x.md.c), t.dxm = fixed(edge.x.md.s);
+  t.xl = fixed(edge.x.lo.c), t.dxl = fixed(edge.x.lo.s);
+
+  if(flags & Primitive::Shade) {
+    auto& shade = self.shade;
+    Shade::Channel* channels[4] = {&shade.r, &shade.g, &shade.b, &shade.a};
+    for(u32 n : range(4)) {
+      t.c[R + n] = fixed(channels[n]->c);
+      t.dx[R + n] = fixed(channels[n]->x);
+      t.de[R + n] = fixed(channels[n]->e);
+    }
+  }
+  if(flags & Primitive::Texture) {
+    auto& texture = self.texture;
+    t.c[S] = fixed(texture.s.c), t.dx[S] = fixed(texture.s.x), t.de[S] = fixed(texture.s.e);
+    t.c[T] = fixed(texture.t.c), t.dx[T] = fixed(texture.t.x), t.de[T] = fixed(texture.t.e);
+    t.c[W] = fixed(texture.w.c), t.dx[W] = fixed(texture.w.x), t.de[W] = fixed(texture.w.e);
+  }
+  if(flags & Primitive::Depth) {
+    auto& zbuffer = self.zbuffer;
+    t.c[Z] = fixed(zbuffer.d), t.dx[Z] = fixed(zbuffer.x), t.de[Z] = fixed(zbuffer.e);
+    t.dz = (abs(fixed(zbuffer.x)) + abs(fixed(zbuffer.y))) >> 13;
+  }
+
+  //scanline y is covered when its center (y * 4 + 2 in 11.2) is within [yh, yl)
+  primitive.y0 = max<s32>(t.yh + 1 >> 2, current.scissor.y.hi >> 2);
+  primitive.y1 = min<s32>(t.yl + 1 >> 2, current.scissor.y.lo >> 2);
+  primitive.y0 = max(primitive.y0, 0);
+  submit(primitive);
+}
+
+//0x24, 0x25, 0x36
+auto RDP::Rasterizer::rectangle(bool textured, bool flip) -> void {
+  u32 cycleType = current.other.cycleType;
+  s32 xh, yh, xl, yl;
+  if(textured) {
+    auto& rectangle = self.rectangle;
+    xh = rectangle.x.hi, yh = rectangle.y.hi;
+    xl = rectangle.x.lo, yl = rectangle.y.lo;
+  } else {
+    auto& rectangle = self.fillRectangle_;
+    xh = rectangle.x.hi, yh = rectangle.y.hi;
+    xl = rectangle.x.lo, yl = rectangle.y.lo;
+  }
+
+  Primitive primitive{};
+  primitive.type = cycleType == 3 ? Primitive::Fill : Primitive::Rectangle;
+  primitive.flags = (textured ? Primitive::Texture : 0) | (flip ? Primitive::Flip : 0);
+  primitive.tile = self.rectangle.tile;
+  auto& r = primitive.rectangle;
+  //copy and fill modes include the lower right edge
+  bool inclusive = cycleType >= 2;
+  r.x0 = max<s32>(xh + 3 >> 2, current.scissor.x.hi >> 2);
+  r.x1 = min<s32>(inclusive ? (xl >> 2) + 1 : xl + 3 >> 2, current.scissor.x.lo >> 2);
+  primitive.y0 = max<s32>(yh + 3 >> 2, current.scissor.y.hi >> 2);
+  primitive.y1 = min<s32>(inclusive ? (yl >> 2) + 1 : yl + 3 >> 2, current.scissor.y.lo >> 2);
+  if(r.x0 >= r.x1) return;
+
+  //texture coordinates at the first covered pixel, in 10.10
+  auto& rectangle = self.rectangle;
+  r.dsdx = sclip<16>(rectangle.s.f);
+  r.dtdy = sclip<16>(rectangle.t.f);
+  if(cycleType == 2) r.dsdx >>= 2;  //copy mode writes four pixels per clock
+  s32 dx = r.x0 - (xh >> 2);
+  s32 dy = primitive.y0 - (yh >> 2);
+  r.s = sclip<16>(rectangle.s.i) << 5;
+  r.t = sclip<16>(rectangle.t.i) << 5;
+  if(!flip) r.s += dx * r.dsdx, r.t += dy * r.dtdy;
+  if( flip) r.s += dy * r.dsdx, r.t += dx * r.dtdy;
+  submit(primitive);
+}
+
+//0x33, 0x34: copies texels from the texture image into TMEM. odd rows of TMEM have their 32-bit words
+//swapped; texel() undoes this, so pre-swapped images loaded with Load_Block and dxt = 0 sample correctly.
+auto RDP::Rasterizer::loadTile(bool block) -> void {
+  auto& image = self.set.texture;
+  Load::Tile load = self.load_.tile;
+  if(block) {
+    load.index = self.load_.block.index;
+    load.s.lo = self.load_.block.s.lo, load.s.hi = self.load_.block.s.hi;
+    load.t.lo = self.load_.block.t.lo, load.t.hi = self.load_.block.t.hi;
+  }
+  auto& tile = update().tiles[load.index];
+  tile.s.lo = load.s.lo, tile.t.lo = load.t.lo;
+  tile.s.hi = load.s.hi, tile.t.hi = load.t.hi;
+
+  u32 bits = 4 << image.size;
+  u32 width = image.width + 1;
+  u32 base = tile.address * 8;
+  u32 line = tile.line * 8;
+  auto& target = tmem().data;
+
+  //writes one texel of the image to the TMEM byte address; 32-bit texels are split across both halves
+  auto store = [&](u32 address, u32 source) {
+    if(image.size == 3) {
+      target[address + 0 & 0x7ff] = rdram.ram.read<Byte>(source + 0, "RDP");
+      target[address + 1 & 0x7ff] = rdram.ram.read<Byte>(source + 1, "RDP");
+      target[address + 0 & 0x7ff | 0x800] = rdram.ram.read<Byte>(source + 2, "RDP");
+      target[address + 1 & 0x7ff | 0x800] = rdram.ram.read<Byte>(source + 3, "RDP");
+    } else {
+      target[address & 0xfff] = rdram.ram.read<Byte>(source, "RDP");
+    }
+  };
+
+  //Load_Block takes whole texel coordinates, and advances the TMEM row by dxt (1.11) every word
+  if(block) {
+    u32 s0 = load.s.lo, s1 = load.s.hi, t0 = load.t.lo, dxt = load.t.hi;
+    if(s1 < s0) return;
+    u32 address = image.dramAddress + (t0 * width + s0) * bits / 8;
+    u32 texels = s1 - s0 + 1;
+    u32 words = image.size == 3 ? (texels + 3) / 4 : (texels * bits / 8 + 7) / 8;
+    hazard(address, image.size == 3 ? words * 16 : words * 8);
+    u32 counter = 0;
+    for(u32 word : range(words)) {
+      u32 row = base + word * 8;
+      u32 swap = (counter >> 11 & 1) << 2;
+      if(image.size == 3) {
+        for(u32 n : range(4)) store(row + n * 2 ^ swap, address + word * 16 + n * 4);
+      } else {
+        for(u32 n : range(8)) store(row + n ^ swap, address + word * 8 + n);
+      }
+      counter += dxt;
+    }
+    return;
+  }
+
+  u32 s0 = load.s.lo >> 2, s1 = load.s.hi >> 2;
+  u32 t0 = load.t.lo >> 2, t1 = load.t.hi >> 2;
+  if(s1 < s0 || t1 < t0) return;
+  u32 bytes = max(1u, (s1 - s0 + 1) * bits / 8);
+  hazard(image.dramAddress + (t0 * width + s0) * bits / 8, ((t1 - t0) * width + (s1 - s0) + 1) * bits / 8 + 4);
+  for(u32 t : range(t1 - t0 + 1)) {
+    u32 source = image.dramAddress + ((t0 + t) * width + s0) * bits / 8;
+    u32 swap = (t & 1) << 2;
+    u32 row = base + t * line;
+    if(image.size == 3) {
+      for(u32 s : range(s1 - s0 + 1)) store(row + s * 2 ^ swap, source + s * 4);
+    } else {
+      for(u32 b : range(bytes)) store(row + b ^ swap, source + b);
+    }
+  }
+}
+
+//0x30: palette entries are stored four times each in the upper half of TMEM
+auto RDP::Rasterizer::loadTLUT() -> void {
+  auto& image = self.set.texture;
+  auto& load = self.tlut;
+  auto& tile = current.tiles[load.index];
+  u32 s0 = load.s.lo >> 2, s1 = load.s.hi >> 2;
+  u32 t0 = load.t.lo >> 2;
+  if(s1 < s0) return;
+  u32 address = image.dramAddress + (t0 * (image.width + 1) + s0) * 2;
+  hazard(address, (s1 - s0 + 1) * 2);
+  auto& target = tmem().data;
+  u32 base = tile.address * 8;
+  for(u32 entry : range(s1 - s0 + 1)) {
+    u8 hi = rdram.ram.read<Byte>(address + entry * 2 + 0, "RDP");
+    u8 lo = rdram.ram.read<Byte>(address + entry * 2 + 1, "RDP");
+    for(u32 copy : range(4)) {
+      target[base + entry * 8 + copy * 2 + 0 & 0xfff] = hi;
+      target[base + entry * 8 + copy * 2 + 1 & 0xfff] = lo;
+    }
+  }
+}
+
+//workers access RDRAM without a peripheral name, as the homebrew debugger is not thread-safe
+auto RDP::Rasterizer::execute(u32 band) -> void {
+  Context context;
+  context.one = {256, 256, 256, 256};
+  context.zero = {0, 0, 0, 0};
+  context.random = 0x9e37'79b9 * (band + 1);
+  for(auto& primitive : primitives) {
+    context.state = &states[primitive.state];
+    context.tmem = &tmems[primitive.tmem];
+    context.primitive = &primitive;
+    context.shade = {};
+    context.combined = {};
+    if(primitive.type == Primitive::Triangle) drawTriangle(context, band);
+    else drawRectangle(context, band);
+  }
+}
+
+//rows are interleaved across the bands in groups of Rows scanlines
+#define ownsRow(y) ((y) / Rows % (threads + 1) == band)
+#define keepsRow(y) (!state.scissor.field || ((y) & 1) == state.scissor.odd)
+
+auto RDP::Rasterizer::drawTriangle(Context& context, u32 band) -> void {
+  auto& state = *context.state;
+  auto& primitive = *context.primitive;
+  auto& t = primitive.triangle;
+  s32 width = state.color.width + 1;
+  s32 left = max<s32>(state.scissor.x.hi >> 2, 0);
+  s32 right = min<s32>(state.scissor.x.lo >> 2, width);
+  s32 top = t.yh & ~3;
+
+  for(s32 y = primitive.y0; y < primitive.y1; y++) {
+    if(!ownsRow(y) || !keepsRow(y)) continue;
+    s64 sub = y * 4 + 2;  //center of the scanline, in 11.2
+    s64 major = t.xh + ((s64)t.dxh * (sub - top) >> 2);
+    s64 minor = sub < t.ym ? t.xm + ((s64)t.dxm * (sub - top) >> 2) : t.xl + ((s64)t.dxl * (sub - t.ym) >> 2);
+    s64 lo = min(major, minor), hi = max(major, minor);
+    //pixel x is covered when its center is within [lo, hi)
+    s32 x0 = max<s64>(lo + 0x7fff >> 16, left);
+    s32 x1 = min<s64>(hi + 0x7fff >> 16, right);
+    if(x0 >= x1) continue;
+
+    s64 value[8];
+    s64 offset = ((s64)x0 << 16) + 0x8000 - major;
+    for(u32 n : range(8)) {
+      value[n] = t.c[n] + ((s64)t.de[n] * (sub - top) >> 2) + ((s64)t.dx[n] * offset >> 16);
+    }
+    span(context, y, x0, x1, value, t.dx);
+  }
+}
+
+auto RDP::Rasterizer::span(Context& context, s32 y, s32 x0, s32 x1, s64 value[8], const s32 dx[8]) -> void {
+  auto& state = *context.state;
+  auto& primitive = *context.primitive;
+  bool shaded = primitive.flags & Primitive::Shade;
+  bool textured = primitive.flags & Primitive::Texture;
+  auto channel = [](s64 value) -> s32 { return value < 0 ? 0 : value >= 0xff'ffff ? 0xff : value >> 16; };
+
+  for(s32 x = x0; x < x1; x++) {
+    if(state.other.cycleType == 3) {
+      fill(context, x, y);
+    } else {
+      if(shaded) context.shade = {channel(value[R]), channel(value[G]), channel(value[B]), channel(value[A])};
+      s32 s = 0, t = 0;
+      if(textured) {
+        s = value[S] >> 16;
+        t = value[T] >> 16;
+        if(state.other.perspective) {
+          s64 w = max<s64>(value[W] >> 16, 1);
+          s = sclamp<18>(((s64)s << 15) / w);
+          t = sclamp<18>(((s64)t << 15) / w);
+        }
+      }
+      s32 z = state.other.zSource ? state.primitiveZ << 3 : sclamp<19>(value[Z] >> 13);
+      s32 dz = state.other.zSource ? (s32)state.primitiveDeltaZ : primitive.triangle.dz;
+      pixel(context, x, y, s, t, max(z, 0), dz);
+    }
+    for(u32 n : range(8)) value[n] += dx[n];
+  }
+}
+
+auto RDP::Rasterizer::drawRectangle(Context& context, u32 band) -> void {
+  auto& state = *context.state;
+  auto& primitive = *context.primitive;
+  auto& r = primitive.rectangle;
+  bool flip = primitive.flags & Primitive::Flip;
+  s32 width = state.color.width + 1;
+  s32 x1 = min(r.x1, width);
+  s32 z = state.primitiveZ << 3;
+
+  for(s32 y = primitive.y0; y < primitive.y1; y++) {
+    if(!ownsRow(y) || !keepsRow(y)) continue;
+    s32 row = y - primitive.y0;
+    for(s32 x = max(r.x0, 0); x < x1; x++) {
+      if(primitive.type == Primitive::Fill) {
+        fill(context, x, y);
+        continue;
+      }
+      s32 column = x - r.x0;
+      s32 s = r.s + (flip ? row : column) * r.dsdx >> 5;
+      s32 t = r.t + (flip ? column : row) * r.dtdy >> 5;
+      if(state.other.cycleType == 2) copy(context, x, y, s, t);
+      else pixel(context, x, y, s, t, z, state.primitiveDeltaZ);
+    }
+  }
+}
+
+#undef ownsRow
+#undef keepsRow
+
+auto RDP::Rasterizer::fill(Context& context, s32 x, s32 y) -> void {
+  auto& state = *context.state;
+  u32 index = y * (state.color.width + 1) + x;
+  u32 color = state.fill;
+  switch(state.color.size) {
+  case 0: case 1: rdram.ram.write<Byte>(state.color.dramAddress + index, color >> 24 - (x & 3) * 8, nullptr); break;
+  case 2: rdram.ram.write<Half>(state.color.dramAddress + index * 2, x & 1 ? color : color >> 16, nullptr); break;
+  case 3: rdram.ram.write<Word>(state.color.dramAddress + index * 4, color, nullptr); break;
+  }
+}
+
+//copy mode writes texels to the color image without any processing beyond the TLUT and alpha compare
+auto RDP::Rasterizer::copy(Context& context, s32 x, s32 y, s32 s, s32 t) -> void {
+  auto& state = *context.state;
+  auto& tile = state.tiles[context.primitive->tile];
+  auto data = context.tmem->data;
+  u32 index = y * (state.color.width + 1) + x;
+
+  s32 sx = s >> 5, ty = t >> 5;
+  u32 address = tile.address * 8 + ty * tile.line * 8;
+  u32 swap = (ty & 1) << 2;
+  u32 value = 0;
+  if(tile.size == 0) value = data[(address + (sx >> 1) ^ swap) & 0xfff] >> (sx & 1 ? 0 : 4) & 15 | tile.palette << 4;
+  if(tile.size == 1) value = data[(address + sx ^ swap) & 0xfff];
+  if(tile.size >= 2) {
+    u32 a = address + sx * 2 ^ swap;
+    value = data[a & 0xfff] << 8 | data[a + 1 & 0xfff];
+  }
+  if(tile.size <= 1 && state.other.tlut) {
+    u32 a = 0x800 + (value & 0xff) * 8;
+    value = data[a] << 8 | data[a + 1];
+  } else if(tile.size <= 1 && state.color.size <= 1) {
+    return rdram.ram.write<Byte>(state.color.dramAddress + index, value, nullptr);
+  }
+  if(state.other.alphaCompare && !(value & 1)) return;
+  if(state.color.size == 3) {
+    Color color = {s32(value >> 11 & 31) << 3, s32(value >> 6 & 31) << 3, s32(value >> 1 & 31) << 3, 0};
+    return rdram.ram.write<Word>(state.color.dramAddress + index * 4, color.r << 24 | color.g << 16 | color.b << 8 | (value & 1) * 0xe0, nullptr);
+  }
+  rdram.ram.write<Half>(state.color.dramAddress + index * 2, value, nullptr);
+}
+
+namespace {
+  //depth is stored as a 14-bit floating point value with more precision close to the far plane
+  auto decompressZ(u32 z) -> s32 {
+    u32 exponent = z >> 11 & 7;
+    u32 mantissa = z & 0x7ff;
+    u32 shift = max<s32>(6 - exponent, 0);
+    return (mantissa << shift) + (0x40000 - (0x40000 >> exponent));
+  }
+
+  auto compressZ(s32 z) -> u32 {
+    u32 inverse = max(0x3ffff - z, 1);
+    u32 exponent = 0;
+    while(exponent < 7 && (inverse & 0x20000 >> exponent) == 0) exponent++;
+    u32 shift = max<s32>(6 - exponent, 0);
+    return exponent << 11 | (z >> shift & 0x7ff);
+  }
+}
+
+auto RDP::Rasterizer::pixel(Context& context, s32 x, s32 y, s32 s, s32 t, s32 z, s32 dz) -> void {
+  auto& state = *context.state;
+  auto& other = state.other;
+  auto& primitive = *context.primitive;
+  u32 index = y * (state.color.width + 1) + x;
+  bool twoCycle = other.cycleType == 1;
+
+  //depth test
+  u32 zaddress = state.mask.dramAddress + index * 2;
+  if(other.zCompare) {
+    s32 stored = decompressZ(rdram.ram.read<Half>(zaddress, nullptr) >> 2);
+    s32 slope = 1;
+    while(slope < dz && slope < 0x10000) slope <<= 1;
+    slope <<= 3;
+    bool pass = stored == 0x3ffff || z < stored;
+    if(other.zMode == 3) pass = stored != 0x3ffff && z - slope <= stored && z + slope >= stored;
+    if(!pass) return;
+  }
+
+  if(primitive.flags & Primitive::Texture) {
+    context.texel0 = sample(context, primitive.tile, s, t);
+    context.texel1 = twoCycle ? sample(context, primitive.tile + 1 & 7, s, t) : context.texel0;
+  } else {
+    context.texel0 = context.texel1 = context.zero;
+  }
+  context.random = context.random * 1103515245 + 12345;
+  s32 noise = (context.random >> 16 & 7) << 6 | 0x20;
+  context.noise = {noise, noise, noise, noise};
+
+  Color color;
+  if(twoCycle) context.combined = combine(context, 0);
+  color = combine(context, 1);
+
+  if(other.alphaCompare) {
+    s32 threshold = other.ditherAlpha ? s32(context.random >> 8 & 0xff) : state.blend.a;
+    if(color.a < threshold) return;
+  }
+
+  //memory color
+  u32 caddress = state.color.dramAddress;
+  switch(state.color.size) {
+  case 0: case 1: {
+    s32 i = rdram.ram.read<Byte>(caddress + index, nullptr);
+    context.memory = {i, i, i, 0xe0};
+  } break;
+  case 2: {
+    u16 value = rdram.ram.read<Half>(caddress + index * 2, nullptr);
+    context.memory = {s32(value >> 8 & 0xf8), s32(value >> 3 & 0xf8), s32(value << 2 & 0xf8), s32(value & 1) * 0xe0};
+  } break;
+  case 3: {
+    u32 value = rdram.ram.read<Word>(caddress + index * 4, nullptr);
+    context.memory = {s32(value >> 24), s32(value >> 16 & 0xff), s32(value >> 8 & 0xff), s32(value & 0xe0)};
+  } break;
+  }
+
+  if(twoCycle) {
+    Color first = blend(context, 0, color);
+    color = {first.r, first.g, first.b, color.a};
+    color = blend(context, 1, color);
+  } else {
+    color = blend(context, 0, color);
+  }
+
+  switch(state.color.size) {
+  case 0: case 1: rdram.ram.write<Byte>(caddress + index, color.r, nullptr); break;
+  case 2: rdram.ram.write<Half>(caddress + index * 2, (color.r >> 3) << 11 | (color.g >> 3) << 6 | (color.b >> 3) << 1 | 1, nullptr); break;
+  case 3: rdram.ram.write<Word>(caddress + index * 4, color.r << 24 | color.g << 16 | color.b << 8 | 0xe0, nullptr); break;
+  }
+  if(other.zUpdate && primitive.flags & Primitive::Depth) {
+    rdram.ram.write<Half>(zaddress, compressZ(min(z, 0x3ffff)) << 2, nullptr);
+  }
+}
+
+//applies the tile's shift and wraps, mirrors or clamps each coordinate before fetching
+auto RDP::Rasterizer::sample(Context& context, u32 index, s32 s, s32 t) -> Color {
+  auto& state = *context.state;
+  auto& tile = state.tiles[index];
+
+  auto shift = [](s32 value, u32 shift) -> s32 {
+    if(shift < 11) return value >> shift;
+    return value << 16 - shift;
+  };
+  s = shift(s, tile.s.shift) - (tile.s.lo << 3);
+  t = shift(t, tile.t.shift) - (tile.t.lo << 3);
+
+  auto wrap = [](s32 value, auto& axis) -> s32 {
+    if(axis.clamp || !axis.mask) {
+      s32 limit = max<s32>((axis.hi >> 2) - (axis.lo >> 2), 0);
+      value = value < 0 ? 0 : value > limit ? limit : value;
+    }
+    if(axis.mask) {
+      u32 mask = min<u32>(axis.mask, 10);
+      if(axis.mirror && value >> mask & 1) value = ~value;
+      value &= (1 << mask) - 1;
+    }
+    return value;
+  };
+
+  s32 s0 = wrap(s >> 5, tile.s), t0 = wrap(t >> 5, tile.t);
+  if(!state.other.sampleType) return texel(context, tile, s0, t0);
+
+  //bilinear filtering uses three texels: the half of the quad nearest to the sample point
+  s32 s1 = wrap((s >> 5) + 1, tile.s), t1 = wrap((t >> 5) + 1, tile.t);
+  s32 fs = s & 31, ft = t & 31;
+  Color a, b, c;
+  if(fs + ft < 32) {
+    a = texel(context, tile, s0, t0);
+    b = texel(context, tile, s1, t0);
+    c = texel(context, tile, s0, t1);
+  } else {
+    a = texel(context, tile, s1, t1);
+    b = texel(context, tile, s0, t1);
+    c = texel(context, tile, s1, t0);
+    fs = 32 - fs, ft = 32 - ft;
+    swap(b, c);
+  }
+  auto mix = [&](s32 a, s32 b, s32 c) { return a + ((b - a) * fs + (c - a) * ft + 16 >> 5); };
+  return {mix(a.r, b.r, c.r), mix(a.g, b.g, c.g), mix(a.b, b.b, c.b), mix(a.a, b.a, c.a)};
+}
+
+auto RDP::Rasterizer::texel(Context& context, const TileDescriptor& tile, s32 s, s32 t) -> Color {
+  auto& state = *context.state;
+  auto data = context.tmem->data;
+  u32 mask = state.other.tlut ? 0x7ff : 0xfff;
+  u32 address = tile.address * 8 + t * tile.line * 8;
+  u32 swap = (t & 1) << 2;
+
+  auto expand3 = [](u32 v) -> s32 { return v << 5 | v << 2 | v >> 1; };
+  auto expand4 = [](u32 v) -> s32 { return v << 4 | v; };
+  auto expand5 = [](u32 v) -> s32 { return v << 3 | v >> 2; };
+  auto rgba16 = [&](u32 v) -> Color { return {expand5(v >> 11 & 31), expand5(v >> 6 & 31), expand5(v >> 1 & 31), (v & 1) ? 0xff : 0}; };
+  auto ia16 = [&](u32 v) -> Color { s32 i = v >> 8; return {i, i, i, s32(v & 0xff)}; };
+
+  u32 value = 0;
+  switch(tile.size) {
+  case 0: value = data[(address + (s >> 1) ^ swap) & mask] >> (s & 1 ? 0 : 4) & 15; break;
+  case 1: value = data[(address + s ^ swap) & mask]; break;
+  case 2: { u32 a = address + s * 2 ^ swap; value = data[a & mask] << 8 | data[a + 1 & mask]; } break;
+  case 3: {
+    u32 a = address + s * 2 ^ swap;
+    value = data[a & 0x7ff] << 24 | data[a + 1 & 0x7ff] << 16 | data[a & 0x7ff | 0x800] << 8 | data[a + 1 & 0x7ff | 0x800];
+  } break;
+  }
+
+  switch(tile.format) {
+  case 0:  //RGBA
+    if(tile.size == 2) return rgba16(value);
+    if(tile.size == 3) return {s32(value >> 24), s32(value >> 16 & 0xff), s32(value >> 8 & 0xff), s32(value & 0xff)};
+    break;
+  case 2: {  //CI
+    u32 index = tile.size == 0 ? tile.palette << 4 | value : value & 0xff;
+    if(!state.other.tlut) { s32 i = tile.size == 0 ? expand4(value) : s32(index); return {i, i, i, i}; }
+    u32 a = 0x800 + index * 8;
+    u32 entry = data[a] << 8 | data[a + 1];
+    return state.other.tlutType ? ia16(entry) : rgba16(entry);
+  }
+  case 3:  //IA
+    if(tile.size == 0) { s32 i = expand3(value >> 1); return {i, i, i, value & 1 ? 0xff : 0}; }
+    if(tile.size == 1) { s32 i = expand4(value >> 4); return {i, i, i, expand4(value & 15)}; }
+    if(tile.size == 2) return ia16(value);
+    break;
+  }
+  //I, YUV and invalid combinations
+  s32 i = tile.size == 0 ? expand4(value) : tile.size == 1 ? s32(value) : s32(value >> (tile.size == 2 ? 8 : 24) & 0xff);
+  return {i, i, i, i};
+}
+
+//(a - b) * c + d, evaluated with the combiner's 9-bit signed arithmetic
+auto RDP::Rasterizer::combine(Context& context, u32 cycle) -> Color {
+  auto& state = *context.state;
+  auto& mode = state.combine;
+  Color key = {state.key.r.center, state.key.g.center, state.key.b.center, 0};
+  Color scale = {state.key.r.scale, state.key.g.scale, state.key.b.scale, 0};
+  s32 k4 = sclip<9>(state.convert.k[4]), k5 = sclip<9>(state.convert.k[5]);
+  s32 fraction = state.primitiveFraction;
+
+  auto subA = [&](u32 code) -> Color {
+    switch(code) {
+    case 0: return context.combined;
+    case 1: return context.texel0;
+    case 2: return context.texel1;
+    case 3: return state.primitive;
+    case 4: return context.shade;
+    case 5: return state.environment;
+    case 6: return context.one;
+    case 7: return context.noise;
+    }
+    return context.zero;
+  };
+  auto subB = [&](u32 code) -> Color {
+    switch(code) {
+    case 0: return context.combined;
+    case 1: return context.texel0;
+    case 2: return context.texel1;
+    case 3: return state.primitive;
+    case 4: return context.shade;
+    case 5: return state.environment;
+    case 6: return key;
+    case 7: return {k4, k4, k4, k4};
+    }
+    return context.zero;
+  };
+  auto mul = [&](u32 code) -> Color {
+    auto splat = [](s32 v) -> Color { return {v, v, v, v}; };
+    switch(code) {
+    case  0: return context.combined;
+    case  1: return context.texel0;
+    case  2: return context.texel1;
+    case  3: return state.primitive;
+    case  4: return context.shade;
+    case  5: return state.environment;
+    case  6: return scale;
+    case  7: return splat(context.combined.a);
+    case  8: return splat(context.texel0.a);
+    case  9: return splat(context.texel1.a);
+    case 10: return splat(state.primitive.a);
+    case 11: return splat(context.shade.a);
+    case 12: return splat(state.environment.a);
+    case 13: return context.zero;  //LOD fraction: mipmapping is not emulated
+    case 14: return splat(fraction);
+    case 15: return splat(k5);
+    }
+    return context.zero;
+  };
+  auto add = [&](u32 code) -> Color {
+    switch(code) {
+    case 0: return context.combined;
+    case 1: return context.texel0;
+    case 2: return context.texel1;
+    case 3: return state.primitive;
+    case 4: return context.shade;
+    case 5: return state.environment;
+    case 6: return context.one;
+    }
+    return context.zero;
+  };
+  auto alpha = [&](u32 code) -> s32 {
+    switch(code) {
+    case 0: return context.combined.a;
+    case 1: return context.texel0.a;
+    case 2: return context.texel1.a;
+    case 3: return state.primitive.a;
+    case 4: return context.shade.a;
+    case 5: return state.environment.a;
+    case 6: return 256;
+    }
+    return 0;
+  };
+  auto alphaMul = [&](u32 code) -> s32 {
+    switch(code) {
+    case 1: return context.texel0.a;
+    case 2: return context.texel1.a;
+    case 3: return state.primitive.a;
+    case 4: return context.shade.a;
+    case 5: return state.environment.a;
+    case 6: return fraction;
+    }
+    return 0;
+  };
+
+  auto expand = [](s32 v) -> s32 { return sclip<9>(v - 0x80) + 0x80; };
+  auto equation = [&](s32 a, s32 b, s32 c, s32 d) -> s32 {
+    s32 v = ((expand(a) - expand(b)) * sclip<9>(c) + 0x80 >> 8) + expand(d);
+    v = sclip<9>(v - 0x80) + 0x80;
+    return v < 0 ? 0 : v > 0xff ? 0xff : v;
+  };
+
+  Color a = subA(mode.sba.color[cycle]);
+  Color b = subB(mode.sbb.color[cycle]);
+  Color c = mul(mode.mul.color[cycle]);
+  Color d = add(mode.add.color[cycle]);
+  return {
+    equation(a.r, b.r, c.r, d.r),
+    equation(a.g, b.g, c.g, d.g),
+    equation(a.b, b.b, c.b, d.b),
+    equation(alpha(mode.sba.alpha[cycle]), alpha(mode.sbb.alpha[cycle]), alphaMul(mode.mul.alpha[cycle]), alpha(mode.add.alpha[cycle])),
+  };
+}
+
+//(p * a + m * b) with 5-bit blend factors; the last cycle only blends when forced
+auto RDP::Rasterizer::blend(Context& context, u32 cycle, Color pixel) -> Color {
+  auto& state = *context.state;
+  auto& other = state.other;
+  bool last = other.cycleType != 1 || cycle == 1;
+
+  auto select = [&](u32 code) -> Color {
+    switch(code) {
+    case 0: return pixel;
+    case 1: return context.memory;
+    case 2: return state.blend;
+    case 3: return state.fog;
+    }
+    return context.zero;
+  };
+  Color p = select(other.blend1a[cycle]);
+  if(last && !other.forceBlend) return p;
+  Color m = select(other.blend2a[cycle]);
+
+  s32 a = 0, b = 0;
+  switch(other.blend1b[cycle]) {
+  case 0: a = pixel.a; break;
+  case 1: a = state.fog.a; break;
+  case 2: a = context.shade.a; break;
+  }
+  switch(other.blend2b[cycle]) {
+  case 0: b = ~a & 0xff; break;
+  case 1: b = context.memory.a; break;
+  case 2: b = 0xff; break;
+  }
+  a >>= 3, b = (b >> 3) + 1;
+  auto mix = [&](s32 p, s32 m) -> s32 { return min(p * a + m * b >> 5, 0xff); };
+  return {mix(p.r, m.r), mix(p.g, m.g), mix(p.b, m.b), pixel.a};
+}
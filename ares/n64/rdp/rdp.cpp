@@ -4,6 +4,7 @@ namespace ares::Nintendo64 {
 
 RDP rdp;
 #include "render.cpp"
+#include "rasterizer.cpp"
 #include "io.cpp"
 #include "debugger.cpp"
 #include "serialization.cpp"
@@ -14,6 +15,7 @@ auto RDP::load(Node::Object parent) -> void {
 }
 
 auto RDP::unload() -> void {
+  rasterizer.kill();
   debugger = {};
   node.reset();
 }
@@ -60,6 +62,7 @@ auto RDP::power(bool reset) -> void {
   fillRectangle_ = {};
   io.bist = {};
   io.test = {};
+  rasterizer.power();
 }
 
 }
@@ -332,6 +332,147 @@ struct RDP : Thread, Memory::RCP<RDP> {
     } x, y;
   } fillRectangle_;
 
+  //rasterizer.cpp: software renderer, used when the Vulkan renderer is unavailable.
+  //primitives are recorded with a snapshot of the state they were issued with, and drawn at Sync_Full
+  //by a pool of threads that each own an interleaved set of scanline bands of the color and depth images.
+  struct Rasterizer {
+    RDP& self;
+    Rasterizer(RDP& self) : self(self) {}
+
+    static constexpr u32 Workers = 15;  //maximum number of threads in addition to the emulation thread
+    static constexpr u32 Rows = 4;      //height of a scanline band
+    static constexpr u32 Limit = 8192;  //primitives recorded before drawing is forced
+
+    struct Color {
+      s32 r, g, b, a;
+    };
+
+    struct TileDescriptor {
+      n3  format;
+      n2  size;
+      n9  line;
+      n9  address;
+      n4  palette;
+      struct {
+        n1  clamp;
+        n1  mirror;
+        n4  mask;
+        n4  shift;
+        n12 lo;  //10.2
+        n12 hi;  //10.2
+      } s, t;
+    };
+
+    struct TMEM {
+      u8 data[4_KiB];
+    };
+
+    struct State {
+      OtherModes other;
+      CombineMode combine;
+      Color fog;
+      Color blend;
+      Color primitive;
+      Color environment;
+      n8  primitiveMinimum;
+      n8  primitiveFraction;
+      n32 fill;
+      n16 primitiveZ;
+      n16 primitiveDeltaZ;
+      Scissor scissor;
+      Convert convert;
+      Key key;
+      Set::Color color;
+      Set::Mask mask;
+      TileDescriptor tiles[8];
+    };
+
+    //triangle attributes in 16.16 fixed point: value at the top of the major edge, and per pixel (x),
+    //along the major edge (e) per scanline
+    enum Attribute : u32 { R, G, B, A, S, T, W, Z };
+
+    struct Primitive {
+      enum Type : u32 { Triangle, Rectangle, Fill } type;
+      enum Flag : u32 { Shade = 1 << 0, Texture = 1 << 1, Depth = 1 << 2, Flip = 1 << 3 };
+      u32 flags;
+      u32 state;
+      u32 tmem;
+      u32 tile;
+      s32 y0, y1;  //covered scanlines, clipped to the scissor
+      union {
+        struct {
+          s32 yh, ym, yl;        //11.2
+          s32 xh, xm, xl;        //16.16
+          s32 dxh, dxm, dxl;     //16.16
+          s32 c[8], dx[8], de[8];
+          s32 dz;                //depth slope, for decal depth tests
+        } triangle;
+        struct {
+          s32 x0, x1;            //covered pixels
+          s32 s, t;              //10.5
+          s32 dsdx, dtdy;        //5.10
+        } rectangle;
+      };
+    };
+
+    //worker-local context for the primitive being drawn
+    struct Context {
+      const State* state;
+      const TMEM* tmem;
+      const Primitive* primitive;
+      Color combined, texel0, texel1, shade, noise, memory;
+      Color one, zero;
+      u32 random;
+    };
+
+    //rasterizer.cpp
+    auto power() -> void;
+    auto kill() -> void;
+    auto main(uintptr band) -> void;
+    auto flush() -> void;
+    auto discard() -> void;
+    auto update() -> State&;
+    auto tmem() -> TMEM&;
+    auto submit(Primitive& primitive) -> void;
+    auto hazard(u32 address, u32 length) -> void;
+
+    auto triangle(u32 flags) -> void;
+    auto rectangle(bool texture, bool flip) -> void;
+    auto loadTile(bool block) -> void;
+    auto loadTLUT() -> void;
+
+    auto execute(u32 band) -> void;
+    auto drawTriangle(Context&, u32 band) -> void;
+    auto drawRectangle(Context&, u32 band) -> void;
+    auto span(Context&, s32 y, s32 x0, s32 x1, s64 value[8], const s32 dx[8]) -> void;
+    auto pixel(Context&, s32 x, s32 y, s32 s, s32 t, s32 z, s32 dz) -> void;
+    auto copy(Context&, s32 x, s32 y, s32 s, s32 t) -> void;
+    auto fill(Context&, s32 x, s32 y) -> void;
+    auto sample(Context&, u32 tile, s32 s, s32 t) -> Color;
+    auto texel(Context&, const TileDescriptor&, s32 s, s32 t) -> Color;
+    auto combine(Context&, u32 cycle) -> Color;
+    auto blend(Context&, u32 cycle, Color pixel) -> Color;
+
+    nall::thread workers[Workers];
+    u32 threads = 0;
+    mutex lock;
+    condition_variable wake;
+    condition_variable done;
+    u32 generation = 0;
+    u32 running = 0;
+    bool quit = false;
+
+    State current;
+    bool stateChanged = true;
+    bool tmemChanged = true;
+    TMEM texture;                //contents of TMEM as of the most recent command
+    vector<State> states;
+    vector<TMEM> tmems;
+    vector<Primitive> primitives;
+    struct Range { u32 lo, hi; };
+    vector<Range> written;       //RDRAM written by the recorded primitives
+  } rasterizer{*this};
+
   struct IO : Memory::RCP<IO> {
     RDP& self;
     IO(RDP& self) : self(self) {}
@@ -560,42 +560,52 @@ auto RDP::invalidOperation() -> void {
 
 //0x08
 auto RDP::unshadedTriangle() -> void {
+  rasterizer.triangle(0);
 }
 
 //0x09
 auto RDP::unshadedZbufferTriangle() -> void {
+  rasterizer.triangle(Rasterizer::Primitive::Depth);
 }
 
 //0x0a
 auto RDP::textureTriangle() -> void {
+  rasterizer.triangle(Rasterizer::Primitive::Texture);
 }
 
 //0x0b
 auto RDP::textureZbufferTriangle() -> void {
+  rasterizer.triangle(Rasterizer::Primitive::Texture | Rasterizer::Primitive::Depth);
 }
 
 //0x0c
 auto RDP::shadedTriangle() -> void {
+  rasterizer.triangle(Rasterizer::Primitive::Shade);
 }
 
 //0x0d
 auto RDP::shadedZbufferTriangle() -> void {
+  rasterizer.triangle(Rasterizer::Primitive::Shade | Rasterizer::Primitive::Depth);
 }
 
 //0x0e
 auto RDP::shadedTextureTriangle() -> void {
+  rasterizer.triangle(Rasterizer::Primitive::Shade | Rasterizer::Primitive::Texture);
 }
 
 //0x0f
 auto RDP::shadedTextureZbufferTriangle() -> void {
+  rasterizer.triangle(Rasterizer::Primitive::Shade | Rasterizer::Primitive::Texture | Rasterizer::Primitive::Depth);
 }
 
 //0x24
 auto RDP::textureRectangle() -> void {
+  rasterizer.rectangle(true, false);
 }
 
 //0x25
 auto RDP::textureRectangleFlip() -> void {
+  rasterizer.rectangle(true, true);
 }
 
 //0x26
@@ -612,6 +622,7 @@ auto RDP::syncTile() -> void {
 
 //0x29
 auto RDP::syncFull() -> void {
+  rasterizer.flush();
   if(!command.crashed) {
     mi.raise(MI::IRQ::DP);
     command.bufferBusy = 0;
@@ -622,74 +633,106 @@ auto RDP::syncFull() -> void {
 
 //0x2a
 auto RDP::setKeyGB() -> void {
+  rasterizer.update().key = key;
 }
 
 //0x2b
 auto RDP::setKeyR() -> void {
+  rasterizer.update().key = key;
 }
 
 //0x2c
 auto RDP::setConvert() -> void {
+  rasterizer.update().convert = convert;
 }
 
 //0x2d
 auto RDP::setScissor() -> void {
+  rasterizer.update().scissor = scissor;
 }
 
 //0x2e
 auto RDP::setPrimitiveDepth() -> void {
+  auto& state = rasterizer.update();
+  state.primitiveZ = primitiveDepth.z;
+  state.primitiveDeltaZ = primitiveDepth.deltaZ;
 }
 
 //0x2f
 auto RDP::setOtherModes() -> void {
+  rasterizer.update().other = other;
 }
 
 //0x30
 auto RDP::loadTLUT() -> void {
+  rasterizer.loadTLUT();
 }
 
 //0x32
 auto RDP::setTileSize() -> void {
+  auto& tile = rasterizer.update().tiles[tileSize.index];
+  tile.s.lo = tileSize.s.lo, tile.t.lo = tileSize.t.lo;
+  tile.s.hi = tileSize.s.hi, tile.t.hi = tileSize.t.hi;
 }
 
 //0x33
 auto RDP::loadBlock() -> void {
+  rasterizer.loadTile(true);
 }
 
 //0x34
 auto RDP::loadTile() -> void {
+  rasterizer.loadTile(false);
 }
 
 //0x35
 auto RDP::setTile() -> void {
+  auto& target = rasterizer.update().tiles[tile.index];
+  target.format  = tile.format;
+  target.size    = tile.size;
+  target.line    = tile.line;
+  target.address = tile.address;
+  target.palette = tile.palette;
+  target.s.clamp = tile.s.clamp, target.s.mirror = tile.s.mirror, target.s.mask = tile.s.mask, target.s.shift = tile.s.shift;
+  target.t.clamp = tile.t.clamp, target.t.mirror = tile.t.mirror, target.t.mask = tile.t.mask, target.t.shift = tile.t.shift;
 }
 
 //0x36
 auto RDP::fillRectangle() -> void {
+  rasterizer.rectangle(false, false);
 }
 
 //0x37
 auto RDP::setFillColor() -> void {
+  rasterizer.update().fill = set.fill.color;
 }
 
 //0x38
 auto RDP::setFogColor() -> void {
+  rasterizer.update().fog = {fog.red, fog.green, fog.blue, fog.alpha};
 }
 
 //0x39
 auto RDP::setBlendColor() -> void {
+  rasterizer.update().blend = {blend.red, blend.green, blend.blue, blend.alpha};
 }
 
 //0x3a
 auto RDP::setPrimitiveColor() -> void {
+  auto& state = rasterizer.update();
+  state.primitive = {primitive.red, primitive.green, primitive.blue, primitive.alpha};
+  state.primitiveMinimum = primitive.minimum;
+  state.primitiveFraction = primitive.fraction;
 }
 
 //0x3b
 auto RDP::setEnvironmentColor() -> void {
+  rasterizer.update().environment = {environment.red, environment.green, environment.blue, environment.alpha};
 }
 
 //0x3c
 auto RDP::setCombineMode() -> void {
+  rasterizer.update().combine = combine;
 }
 
 //0x3d
@@ -698,8 +741,10 @@ auto RDP::setTextureImage() -> void {
 
 //0x3e
 auto RDP::setMaskImage() -> void {
+  rasterizer.update().mask = set.mask;
 }
 
 //0x3f
 auto RDP::setColorImage() -> void {
+  rasterizer.update().color = set.color;
 }
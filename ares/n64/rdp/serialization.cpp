@@ -1,6 +1,10 @@
 auto RDP::serialize(serializer& s) -> void {
   Thread::serialize(s);
 
+  //pending primitives belong to the frame being saved, or to the one being replaced
+  if(s.writing()) rasterizer.flush();
+  if(s.reading()) rasterizer.discard();
+
   s(command.start);
   s(command.end);
   s(command.current);
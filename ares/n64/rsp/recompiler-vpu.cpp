@@ -0,0 +1,524 @@
+//VU computational instructions are emitted inline where possible, rather than through callvu().
+//the accumulator and flags live in the VU structure between instructions: every instruction is
+//followed by a call to instructionEpilogue(), which does not preserve host vector registers.
+
+#define Vdn (instruction >>  6 & 31)
+#define Vsn (instruction >> 11 & 31)
+#define Vtn (instruction >> 16 & 31)
+#define E   (instruction >> 21 & 15)
+#define Vd  offsetof(VU, r) + Vdn * sizeof(r128)
+#define Vs  offsetof(VU, r) + Vsn * sizeof(r128)
+#define Vt  offsetof(VU, r) + Vtn * sizeof(r128)
+#define ACCH offsetof(VU, acch)
+#define ACCM offsetof(VU, accm)
+#define ACCL offsetof(VU, accl)
+#define VCOH offsetof(VU, vcoh)
+#define VCOL offsetof(VU, vcol)
+#define VCCL offsetof(VU, vccl)
+
+auto RSP::Recompiler::emitVectorOp(u32 instruction) -> bool {
+  #if defined(ARCHITECTURE_AMD64) && ARCHITECTURE_SUPPORTS_SSE4_1
+  if constexpr(Accuracy::RSP::SIMD) return emitVectorSSE(instruction);
+  #endif
+  return emitVectorSIMD(instruction);
+}
+
+//loads a 128-bit VU field (relative to the VU structure) into a host vector register
+auto RSP::Recompiler::vload(u32 x, sljit_sw offset) -> void {
+  sljit_emit_simd_mov(compiler, SLJIT_SIMD_LOAD | SLJIT_SIMD_REG_128, SLJIT_FR(x), SLJIT_MEM1(SLJIT_S2), offset);
+}
+
+auto RSP::Recompiler::vstore(sljit_sw offset, u32 x) -> void {
+  sljit_emit_simd_mov(compiler, SLJIT_SIMD_STORE | SLJIT_SIMD_REG_128, SLJIT_FR(x), SLJIT_MEM1(SLJIT_S2), offset);
+}
+
+#if defined(ARCHITECTURE_AMD64) && ARCHITECTURE_SUPPORTS_SSE4_1
+//SSE2, SSSE3 and SSE4.1 register-register forms: 66 0F op, or 66 0F 38 op
+namespace SSE {
+  enum : u32 {
+    MOVDQA   = 0x006f,
+    PUNPCKLWD= 0x0061,
+    PUNPCKHWD= 0x0069,
+    PACKSSDW = 0x006b,
+    PCMPGTW  = 0x0065,
+    PCMPEQW  = 0x0075,
+    PSHIFTW  = 0x0071,  //immediate group: /2 = psrlw, /4 = psraw, /6 = psllw
+    PMULLW   = 0x00d5,
+    PSUBUSW  = 0x00d9,
+    PAND     = 0x00db,
+    PADDUSW  = 0x00dd,
+    PANDN    = 0x00df,
+    PMULHUW  = 0x00e4,
+    PMULHW   = 0x00e5,
+    PSUBSW   = 0x00e9,
+    PMINSW   = 0x00ea,
+    POR      = 0x00eb,
+    PADDSW   = 0x00ed,
+    PMAXSW   = 0x00ee,
+    PXOR     = 0x00ef,
+    PSUBW    = 0x00f9,
+    PADDW    = 0x00fd,
+    PSHUFB   = 0x3800,
+    PBLENDVB = 0x3810,  //xmm0 is the implicit mask operand
+    PSRLW = 2, PSRAW = 4, PSLLW = 6,
+  };
+}
+
+//x = x op y
+auto RSP::Recompiler::vsse(u32 opcode, u32 x, u32 y) -> void {
+  u32 d = sljit_get_register_index(SLJIT_FLOAT_REGISTER, SLJIT_FR(x));
+  u32 s = sljit_get_register_index(SLJIT_FLOAT_REGISTER, SLJIT_FR(y));
+  u8 code[6];
+  u32 size = 0;
+  code[size++] = 0x66;
+  if(d >= 8 || s >= 8) code[size++] = 0x40 | (d >= 8) << 2 | (s >= 8) << 0;
+  code[size++] = 0x0f;
+  if(opcode >> 8) code[size++] = opcode >> 8;
+  code[size++] = opcode;
+  code[size++] = 0xc0 | (d & 7) << 3 | (s & 7) << 0;
+  sljit_emit_op_custom(compiler, code, size);
+}
+
+//x = x shift amount
+auto RSP::Recompiler::vshift(u32 group, u32 x, u8 amount) -> void {
+  u32 r = sljit_get_register_index(SLJIT_FLOAT_REGISTER, SLJIT_FR(x));
+  u8 code[6];
+  u32 size = 0;
+  code[size++] = 0x66;
+  if(r >= 8) code[size++] = 0x41;
+  code[size++] = 0x0f;
+  code[size++] = SSE::PSHIFTW;
+  code[size++] = 0xc0 | group << 3 | (r & 7) << 0;
+  code[size++] = amount;
+  sljit_emit_op_custom(compiler, code, size);
+}
+
+auto RSP::Recompiler::emitVectorSSE(u32 instruction) -> bool {
+  using namespace SSE;
+  alignas(16) static const u8 shuffle[16][16] = {
+    //vector
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15},  //01234567
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15},  //01234567
+    //scalar quarter
+    { 2, 3, 2, 3, 6, 7, 6, 7,10,11,10,11,14,15,14,15},  //00224466
+    { 0, 1, 0, 1, 4, 5, 4, 5, 8, 9, 8, 9,12,13,12,13},  //11335577
+    //scalar half
+    { 6, 7, 6, 7, 6, 7, 6, 7,14,15,14,15,14,15,14,15},  //00004444
+    { 4, 5, 4, 5, 4, 5, 4, 5,12,13,12,13,12,13,12,13},  //11115555
+    { 2, 3, 2, 3, 2, 3, 2, 3,10,11,10,11,10,11,10,11},  //22226666
+    { 0, 1, 0, 1, 0, 1, 0, 1, 8, 9, 8, 9, 8, 9, 8, 9},  //33337777
+    //scalar whole
+    {14,15,14,15,14,15,14,15,14,15,14,15,14,15,14,15},  //00000000
+    {12,13,12,13,12,13,12,13,12,13,12,13,12,13,12,13},  //11111111
+    {10,11,10,11,10,11,10,11,10,11,10,11,10,11,10,11},  //22222222
+    { 8, 9, 8, 9, 8, 9, 8, 9, 8, 9, 8, 9, 8, 9, 8, 9},  //33333333
+    { 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7},  //44444444
+    { 4, 5, 4, 5, 4, 5, 4, 5, 4, 5, 4, 5, 4, 5, 4, 5},  //55555555
+    { 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3},  //66666666
+    { 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1},  //77777777
+  };
+
+  switch(instruction & 0x3f) {
+  case range2(0x00, 0x01):  //VMULF, VMULU
+  case range6(0x04, 0x09):  //VMUDL, VMUDM, VMUDN, VMUDH, VMACF, VMACU
+  case range4(0x0c, 0x0f):  //VMADL, VMADM, VMADN, VMADH
+  case range2(0x10, 0x11):  //VADD, VSUB
+  case range7(0x27, 0x2d):  //VMRG, VAND, VNAND, VOR, VNOR, VXOR, VNXOR
+    break;
+  default:
+    return false;
+  }
+
+  //x1 = vs, x2 = vt(e); x0 is reserved for pblendvb masks
+  enum : u32 { x0, x1, x2, x3, x4, x5 };
+  vload(x1, Vs);
+  vload(x2, Vt);
+  if(E >= 2) {
+    sljit_emit_simd_mov(compiler, SLJIT_SIMD_LOAD | SLJIT_SIMD_REG_128 | SLJIT_SIMD_MEM_ALIGNED_128,
+      SLJIT_FR(x3), SLJIT_MEM0(), (sljit_sw)shuffle[E]);
+    vsse(PSHUFB, x2, x3);
+  }
+
+  switch(instruction & 0x3f) {
+
+  //VMULF Vd,Vs,Vt(e)
+  //VMULU Vd,Vs,Vt(e)
+  case 0x00:
+  case 0x01: {
+    bool U = instruction & 1;
+    vsse(MOVDQA, x3, x1); vsse(PMULLW, x3, x2);   //lo
+    vsse(MOVDQA, x4, x3); vshift(PSRLW, x4, 15);  //sign1
+    vsse(PADDW, x3, x3);
+    vsse(PCMPEQW, x5, x5); vshift(PSLLW, x5, 15);  //round
+    vsse(MOVDQA, x0, x1); vsse(PCMPEQW, x0, x2);  //neq
+    vsse(PMULHW, x1, x2);                         //hi
+    vsse(MOVDQA, x2, x3); vshift(PSRLW, x2, 15);  //sign2
+    vsse(PADDW, x5, x3);
+    vstore(ACCL, x5);
+    vsse(PADDW, x4, x2);
+    vshift(PSLLW, x1, 1);
+    vsse(PADDW, x1, x4);
+    vstore(ACCM, x1);
+    vsse(MOVDQA, x2, x1); vshift(PSRAW, x2, 15);  //neg
+    vsse(MOVDQA, x4, x0); vsse(PANDN, x4, x2);
+    vstore(ACCH, x4);
+    if(!U) {
+      vsse(MOVDQA, x3, x0); vsse(PAND, x3, x2);   //eq
+      vsse(PADDW, x1, x3);
+      vstore(Vd, x1);
+    } else {
+      vsse(POR, x1, x2);
+      vsse(PANDN, x4, x1);
+      vstore(Vd, x4);
+    }
+    return true;
+  }
+
+  //VMUDL Vd,Vs,Vt(e)
+  case 0x04: {
+    vsse(PMULHUW, x1, x2);
+    vstore(ACCL, x1);
+    vstore(Vd, x1);
+    vsse(PXOR, x3, x3);
+    vstore(ACCM, x3);
+    vstore(ACCH, x3);
+    return true;
+  }
+
+  //VMUDM Vd,Vs,Vt(e)
+  //VMUDN Vd,Vs,Vt(e)
+  case 0x05:
+  case 0x06: {
+    bool N = instruction & 2;
+    vsse(MOVDQA, x3, x1); vsse(PMULLW, x3, x2);
+    vstore(ACCL, x3);
+    vsse(MOVDQA, x4, x1); vsse(PMULHUW, x4, x2);
+    vsse(MOVDQA, x5, N ? x2 : x1); vshift(PSRAW, x5, 15);  //sign
+    vsse(PAND, x5, N ? x1 : x2);
+    vsse(PSUBW, x4, x5);
+    vstore(ACCM, x4);
+    vstore(Vd, N ? x3 : x4);
+    vshift(PSRAW, x4, 15);
+    vstore(ACCH, x4);
+    return true;
+  }
+
+  //VMUDH Vd,Vs,Vt(e)
+  case 0x07: {
+    vsse(MOVDQA, x3, x1); vsse(PMULLW, x3, x2);
+    vsse(MOVDQA, x4, x1); vsse(PMULHW, x4, x2);
+    vstore(ACCM, x3);
+    vstore(ACCH, x4);
+    vsse(MOVDQA, x5, x3);
+    vsse(PUNPCKLWD, x5, x4);
+    vsse(PUNPCKHWD, x3, x4);
+    vsse(PACKSSDW, x5, x3);
+    vstore(Vd, x5);
+    vsse(PXOR, x1, x1);
+    vstore(ACCL, x1);
+    return true;
+  }
+
+  //VMACF Vd,Vs,Vt(e)
+  //VMACU Vd,Vs,Vt(e)
+  case 0x08:
+  case 0x09: {
+    bool U = instruction & 1;
+    vsse(MOVDQA, x3, x1); vsse(PMULLW, x3, x2);   //lo
+    vsse(PMULHW, x1, x2);                         //hi
+    vsse(MOVDQA, x4, x1); vshift(PSLLW, x4, 1);   //md
+    vsse(MOVDQA, x2, x3); vshift(PSRLW, x2, 15);  //carry
+    vshift(PSRAW, x1, 15);
+    vsse(POR, x4, x2);
+    vshift(PSLLW, x3, 1);
+    vload(x5, ACCL);
+    vsse(MOVDQA, x2, x5); vsse(PADDUSW, x2, x3);  //omask
+    vsse(PADDW, x5, x3);
+    vstore(ACCL, x5);
+    vsse(PCMPEQW, x2, x5);
+    vsse(PXOR, x3, x3);                           //zero
+    vsse(PCMPEQW, x2, x3);
+    vsse(PSUBW, x4, x2);
+    vsse(MOVDQA, x5, x4); vsse(PCMPEQW, x5, x3);  //carry
+    vsse(PAND, x5, x2);
+    vsse(PSUBW, x1, x5);
+    vload(x5, ACCM);
+    vsse(MOVDQA, x2, x5); vsse(PADDUSW, x2, x4);  //omask
+    vsse(PADDW, x5, x4);
+    vstore(ACCM, x5);
+    vsse(PCMPEQW, x2, x5);
+    vsse(PCMPEQW, x2, x3);
+    vload(x4, ACCH);
+    vsse(PADDW, x4, x1);
+    vsse(PSUBW, x4, x2);
+    vstore(ACCH, x4);
+    if(!U) {
+      vsse(MOVDQA, x1, x5);
+      vsse(PUNPCKLWD, x1, x4);
+      vsse(PUNPCKHWD, x5, x4);
+      vsse(PACKSSDW, x1, x5);
+      vstore(Vd, x1);
+    } else {
+      vsse(MOVDQA, x1, x5); vshift(PSRAW, x1, 15);  //mmask
+      vsse(MOVDQA, x2, x4); vshift(PSRAW, x2, 15);  //hmask
+      vsse(POR, x1, x5);
+      vsse(MOVDQA, x0, x4); vsse(PCMPGTW, x0, x3);  //omask
+      vsse(PANDN, x2, x1);
+      vsse(POR, x2, x0);
+      vstore(Vd, x2);
+    }
+    return true;
+  }
+
+  //VMADL Vd,Vs,Vt(e)
+  case 0x0c: {
+    vsse(PMULHUW, x1, x2);                        //hi
+    vload(x5, ACCL);
+    vsse(MOVDQA, x2, x5); vsse(PADDUSW, x2, x1);  //omask
+    vsse(PADDW, x5, x1);
+    vstore(ACCL, x5);
+    vsse(PCMPEQW, x2, x5);
+    vsse(PXOR, x3, x3);                           //zero
+    vsse(PCMPEQW, x2, x3);
+    vsse(MOVDQA, x1, x3); vsse(PSUBW, x1, x2);
+    vload(x4, ACCM);
+    vsse(MOVDQA, x2, x4); vsse(PADDUSW, x2, x1);
+    vsse(PADDW, x4, x1);
+    vstore(ACCM, x4);
+    vsse(PCMPEQW, x2, x4);
+    vsse(PCMPEQW, x2, x3);
+    vload(x1, ACCH);
+    vsse(PSUBW, x1, x2);
+    vstore(ACCH, x1);
+    vsse(MOVDQA, x2, x1); vshift(PSRAW, x2, 15);  //nhi
+    vsse(MOVDQA, x3, x4); vshift(PSRAW, x3, 15);  //nmd
+    vsse(PCMPEQW, x1, x2);                        //shi
+    vsse(PCMPEQW, x3, x2);                        //smd
+    vsse(MOVDQA, x0, x3); vsse(PAND, x0, x1);     //cmask
+    vsse(PXOR, x3, x3);
+    vsse(PCMPEQW, x2, x3);                        //cval
+    vsse(PBLENDVB, x2, x5);
+    vstore(Vd, x2);
+    return true;
+  }
+
+  //VMADM Vd,Vs,Vt(e)
+  case 0x0d: {
+    vsse(MOVDQA, x3, x1); vsse(PMULLW, x3, x2);   //lo
+    vsse(MOVDQA, x4, x1); vsse(PMULHUW, x4, x2);  //hi
+    vsse(MOVDQA, x5, x1); vshift(PSRAW, x5, 15);  //sign
+    vsse(PAND, x5, x2);
+    vsse(PSUBW, x4, x5);
+    vload(x5, ACCL);
+    vsse(MOVDQA, x2, x5); vsse(PADDUSW, x2, x3);  //omask
+    vsse(PADDW, x5, x3);
+    vstore(ACCL, x5);
+    vsse(PCMPEQW, x2, x5);
+    vsse(PXOR, x3, x3);                           //zero
+    vsse(PCMPEQW, x2, x3);
+    vsse(PSUBW, x4, x2);
+    vload(x5, ACCM);
+    vsse(MOVDQA, x2, x5); vsse(PADDUSW, x2, x4);
+    vsse(PADDW, x5, x4);
+    vstore(ACCM, x5);
+    vsse(PCMPEQW, x2, x5);
+    vsse(PCMPEQW, x2, x3);
+    vshift(PSRAW, x4, 15);
+    vload(x1, ACCH);
+    vsse(PADDW, x1, x4);
+    vsse(PSUBW, x1, x2);
+    vstore(ACCH, x1);
+    vsse(MOVDQA, x2, x5);
+    vsse(PUNPCKLWD, x2, x1);
+    vsse(PUNPCKHWD, x5, x1);
+    vsse(PACKSSDW, x2, x5);
+    vstore(Vd, x2);
+    return true;
+  }
+
+  //VMADN Vd,Vs,Vt(e)
+  case 0x0e: {
+    vsse(MOVDQA, x3, x1); vsse(PMULLW, x3, x2);   //lo
+    vsse(MOVDQA, x4, x1); vsse(PMULHUW, x4, x2);  //hi
+    vsse(MOVDQA, x5, x2); vshift(PSRAW, x5, 15);  //sign
+    vsse(PAND, x5, x1);
+    vsse(PSUBW, x4, x5);
+    vload(x5, ACCL);
+    vsse(MOVDQA, x2, x5); vsse(PADDUSW, x2, x3);  //omask
+    vsse(PADDW, x5, x3);
+    vstore(ACCL, x5);
+    vsse(PCMPEQW, x2, x5);
+    vsse(PXOR, x3, x3);                           //zero
+    vsse(PCMPEQW, x2, x3);
+    vsse(PSUBW, x4, x2);
+    vload(x1, ACCM);
+    vsse(MOVDQA, x2, x1); vsse(PADDUSW, x2, x4);
+    vsse(PADDW, x1, x4);
+    vstore(ACCM, x1);
+    vsse(PCMPEQW, x2, x1);
+    vsse(PCMPEQW, x2, x3);
+    vshift(PSRAW, x4, 15);
+    vload(x3, ACCH);
+    vsse(PADDW, x3, x4);
+    vsse(PSUBW, x3, x2);
+    vstore(ACCH, x3);
+    vsse(MOVDQA, x2, x3); vshift(PSRAW, x2, 15);  //nhi
+    vsse(MOVDQA, x4, x1); vshift(PSRAW, x4, 15);  //nmd
+    vsse(PCMPEQW, x3, x2);                        //shi
+    vsse(PCMPEQW, x4, x2);                        //smd
+    vsse(MOVDQA, x0, x4); vsse(PAND, x0, x3);     //cmask
+    vsse(PXOR, x1, x1);
+    vsse(PCMPEQW, x2, x1);                        //cval
+    vsse(PBLENDVB, x2, x5);
+    vstore(Vd, x2);
+    return true;
+  }
+
+  //VMADH Vd,Vs,Vt(e)
+  case 0x0f: {
+    vsse(MOVDQA, x3, x1); vsse(PMULLW, x3, x2);   //lo
+    vsse(PMULHW, x1, x2);                         //hi
+    vload(x5, ACCM);
+    vsse(MOVDQA, x2, x5); vsse(PADDUSW, x2, x3);  //omask
+    vsse(PADDW, x5, x3);
+    vstore(ACCM, x5);
+    vsse(PCMPEQW, x2, x5);
+    vsse(PXOR, x3, x3);
+    vsse(PCMPEQW, x2, x3);
+    vsse(PSUBW, x1, x2);
+    vload(x4, ACCH);
+    vsse(PADDW, x4, x1);
+    vstore(ACCH, x4);
+    vsse(MOVDQA, x2, x5);
+    vsse(PUNPCKLWD, x2, x4);
+    vsse(PUNPCKHWD, x5, x4);
+    vsse(PACKSSDW, x2, x5);
+    vstore(Vd, x2);
+    return true;
+  }
+
+  //VADD Vd,Vs,Vt(e)
+  case 0x10: {
+    vload(x3, VCOL);
+    vsse(MOVDQA, x4, x1); vsse(PADDW, x4, x2);    //sum
+    vsse(PSUBW, x4, x3);
+    vstore(ACCL, x4);
+    vsse(MOVDQA, x5, x1); vsse(PMINSW, x5, x2);   //min
+    vsse(PMAXSW, x1, x2);                         //max
+    vsse(PSUBSW, x5, x3);
+    vsse(PADDSW, x5, x1);
+    vstore(Vd, x5);
+    vsse(PXOR, x3, x3);
+    vstore(VCOL, x3);
+    vstore(VCOH, x3);
+    return true;
+  }
+
+  //VSUB Vd,Vs,Vt(e)
+  case 0x11: {
+    vload(x3, VCOL);
+    vsse(MOVDQA, x4, x2); vsse(PSUBW, x4, x3);    //udiff
+    vsse(MOVDQA, x5, x2); vsse(PSUBSW, x5, x3);   //sdiff
+    vsse(MOVDQA, x2, x1); vsse(PSUBW, x2, x4);
+    vstore(ACCL, x2);
+    vsse(MOVDQA, x3, x5); vsse(PCMPGTW, x3, x4);  //ov
+    vsse(PSUBSW, x1, x5);
+    vsse(PADDSW, x1, x3);
+    vstore(Vd, x1);
+    vsse(PXOR, x2, x2);
+    vstore(VCOL, x2);
+    vstore(VCOH, x2);
+    return true;
+  }
+
+  //VMRG Vd,Vs,Vt(e)
+  case 0x27: {
+    vload(x0, VCCL);
+    vsse(PBLENDVB, x2, x1);
+    vstore(ACCL, x2);
+    vstore(Vd, x2);
+    vsse(PXOR, x3, x3);
+    vstore(VCOH, x3);
+    vstore(VCOL, x3);
+    return true;
+  }
+
+  //VAND, VNAND, VOR, VNOR, VXOR, VNXOR Vd,Vs,Vt(e)
+  case range6(0x28, 0x2d): {
+    static constexpr u32 logic[3] = {PAND, POR, PXOR};
+    vsse(logic[(instruction & 0x3f) - 0x28 >> 1], x1, x2);
+    if(instruction & 1) {
+      vsse(PCMPEQW, x3, x3);
+      vsse(PXOR, x1, x3);
+    }
+    vstore(ACCL, x1);
+    vstore(Vd, x1);
+    return true;
+  }
+
+  }
+
+  return false;
+}
+#endif
+
+//portable path: the bitwise instructions, using the SIMD operations sljit provides on every host.
+//element selectors that require a shuffle are still handled through callvu().
+auto RSP::Recompiler::emitVectorSIMD(u32 instruction) -> bool {
+  if(!sljit_has_cpu_feature(SLJIT_HAS_SIMD)) return false;
+  if(E >= 2 && E < 8) return false;
+
+  static constexpr sljit_s32 type = SLJIT_SIMD_REG_128 | SLJIT_SIMD_ELEM_16;
+  u32 op = instruction & 0x3f;
+  if(op < 0x27 || op > 0x2d) return false;
+  if(sljit_emit_simd_op2(compiler, type | SLJIT_SIMD_TEST | SLJIT_SIMD_OP2_XOR, SLJIT_FR0, SLJIT_FR0, SLJIT_FR0)) return false;
+  if(E >= 8 && sljit_emit_simd_replicate(compiler, type | SLJIT_SIMD_TEST, SLJIT_FR0, SLJIT_MEM1(SLJIT_S2), 0)) return false;
+
+  //x1 = vs, x2 = vt(e)
+  enum : u32 { x0, x1, x2, x3 };
+  vload(x1, Vs);
+  if(E < 8) {
+    vload(x2, Vt);
+  } else {
+    sljit_emit_simd_replicate(compiler, type, SLJIT_FR(x2), SLJIT_MEM1(SLJIT_S2), Vt + (15 - E) * sizeof(u16));
+  }
+
+  //VMRG Vd,Vs,Vt(e)
+  if(op == 0x27) {
+    vload(x0, VCCL);
+    sljit_emit_simd_op2(compiler, type | SLJIT_SIMD_OP2_XOR, SLJIT_FR(x1), SLJIT_FR(x1), SLJIT_FR(x2));
+    sljit_emit_simd_op2(compiler, type | SLJIT_SIMD_OP2_AND, SLJIT_FR(x1), SLJIT_FR(x1), SLJIT_FR(x0));
+    sljit_emit_simd_op2(compiler, type | SLJIT_SIMD_OP2_XOR, SLJIT_FR(x1), SLJIT_FR(x1), SLJIT_FR(x2));
+    vstore(ACCL, x1);
+    vstore(Vd, x1);
+    sljit_emit_simd_op2(compiler, type | SLJIT_SIMD_OP2_XOR, SLJIT_FR(x3), SLJIT_FR(x3), SLJIT_FR(x3));
+    vstore(VCOH, x3);
+    vstore(VCOL, x3);
+    return true;
+  }
+
+  //VAND, VNAND, VOR, VNOR, VXOR, VNXOR Vd,Vs,Vt(e)
+  static constexpr sljit_s32 logic[3] = {SLJIT_SIMD_OP2_AND, SLJIT_SIMD_OP2_OR, SLJIT_SIMD_OP2_XOR};
+  sljit_emit_simd_op2(compiler, type | logic[op - 0x28 >> 1], SLJIT_FR(x1), SLJIT_FR(x1), SLJIT_FR(x2));
+  if(instruction & 1) {
+    sljit_emit_simd_mov(compiler, SLJIT_SIMD_LOAD | SLJIT_SIMD_REG_128, SLJIT_FR(x3), SLJIT_MEM0(), (sljit_sw)&invert);
+    sljit_emit_simd_op2(compiler, type | SLJIT_SIMD_OP2_XOR, SLJIT_FR(x1), SLJIT_FR(x1), SLJIT_FR(x3));
+  }
+  vstore(ACCL, x1);
+  vstore(Vd, x1);
+  return true;
+}
+
+#undef Vdn
+#undef Vsn
+#undef Vtn
+#undef E
+#undef Vd
+#undef Vs
+#undef Vt
+#undef ACCH
+#undef ACCM
+#undef ACCL
+#undef VCOH
+#undef VCOL
+#undef VCCL
@@ -43,12 +43,32 @@ auto RSP::Recompiler::block(u12 address) -> Block* {
   BlockHashPair pair;
   pair.hashcode = hashcode;
   if(auto result = blocks.find(pair)) {
+    result->block->used = ++uses;
     return context[address >> 2] = result->block;
   }
 
+  if(unlikely(allocator.available() < 1_MiB)) {
+    evict();
+    if(auto result = blocks.find(pair)) return context[address >> 2] = result->block;
+  }
+
+  u32 available = allocator.available();
   auto block = emit(address);
   assert(block->size == size);
   memory::jitprotect(true);
+  block->used = ++uses;
+
+  //remember the source of the block, for eviction and for the translation cache
+  Source source;
+  source.hashcode = hashcode;
+  source.address = address;
+  source.pipeline = self.pipeline;
+  for(u12 offset = 0; offset < size; offset += 4) {
+    source.words.append(self.imem.read<Word>(address + offset));
+  }
+  source.bytes = available - allocator.available();
+  source.block = block;
+  remember(source);
 
   pair.block = block;
   if(auto result = blocks.insert(pair)) {
@@ -58,17 +78,151 @@ auto RSP::Recompiler::block(u12 address) -> Block* {
   throw;  //should never occur
 }
 
-auto RSP::Recompiler::emit(u12 address) -> Block* {
-  if(unlikely(allocator.available() < 1_MiB)) {
-    print("RSP allocator flush\n");
-    allocator.release();
-    reset();
+auto RSP::Recompiler::remember(const Source& source) -> void {
+  //blocks are retranslated after reset(), so the same source may be seen more than once
+  for(auto& entry : sources) {
+    if(entry.hashcode == source.hashcode) return (void)(entry = source);
   }
+  sources.append(source);
+}
 
+//retranslates a block from its source, without disturbing the current IMEM and pipeline state
+auto RSP::Recompiler::translate(Source& source) -> bool {
+  u12 address = source.address;
+  u12 size = source.words.size() * 4;
+  if(!size || source.words.size() > 1024) return false;
+
+  vector<u32> words;
+  for(u12 offset = 0; offset < size; offset += 4) {
+    words.append(self.imem.read<Word>(address + offset));
+    self.imem.write<Word>(address + offset, source.words[offset >> 2]);
+  }
+  auto pipeline = self.pipeline;
+  self.pipeline = source.pipeline;
+
+  //a source whose hash does not match (eg from a stale cache file) is discarded
+  bool valid = measure(address) == size && (hash(address, size) ^ self.pipeline.hash()) == source.hashcode;
+  BlockHashPair pair;
+  pair.hashcode = source.hashcode;
+  if(valid && !blocks.find(pair)) {
+    u32 available = allocator.available();
+    auto block = emit(address);
+    memory::jitprotect(true);
+    block->used = source.used;
+    source.bytes = available - allocator.available();
+    source.block = block;
+    pair.block = block;
+    blocks.insert(pair);
+  }
+
+  self.pipeline = pipeline;
+  for(u12 offset = 0; offset < size; offset += 4) {
+    self.imem.write<Word>(address + offset, words[offset >> 2]);
+  }
+  return valid;
+}
+
+//orders sources from most to least recently used, and drops those beyond half of the code allocator
+auto RSP::Recompiler::trim() -> void {
+  for(auto block : context) {
+    if(block) block->used = uses;  //resident blocks count as in use
+  }
+  for(auto& source : sources) {
+    if(source.block) source.used = source.block->used;
+  }
+  sources.sort([](auto& lhs, auto& rhs) { return lhs.used > rhs.used; });
+
+  u32 budget = allocator.capacity() / 2;
+  for(u32 index : range(sources.size())) {
+    if(sources[index].bytes > budget) {
+      sources.resize(index);
+      break;
+    }
+    budget -= sources[index].bytes;
+  }
+}
+
+auto RSP::Recompiler::retranslate() -> void {
+  vector<Source> kept;
+  for(auto& source : sources) {
+    if(translate(source)) kept.append(source);
+  }
+  sources = kept;
+}
+
+//least-recently-used eviction: rather than discarding every block when the allocator fills,
+//the most recently used half is retranslated into the emptied allocator.
+auto RSP::Recompiler::evict() -> void {
+  trim();
+  allocator.release();
+  reset();
+  retranslate();
+}
+
+//the translation cache stores sources rather than host code: translated blocks embed the
+//addresses of host functions, which differ between builds and (with ASLR) between sessions.
+//microcode is shared across most games, so its blocks are retranslated on power-on instead
+//of during the first frames of emulation.
+auto RSP::Recompiler::location() -> string {
+  return {Path::userData(), "ares/Cache/"};
+}
+
+auto RSP::Recompiler::loadCache() -> void {
+  auto fp = file::open({location(), "rsp.bin"}, file::mode::read);
+  if(!fp || fp.reads(8) != "ares-rsp" || fp.readl<u32>(4) != CacheVersion) return;
+
+  u32 count = fp.readl<u32>(4);
+  for(u32 index : range(min(count, 65536u))) {
+    Source source;
+    source.hashcode = fp.readl<u64>(8);
+    source.address = fp.readl<u16>(2);
+    source.pipeline = {};
+    source.pipeline.singleIssue = fp.readl<u8>(1);
+    for(auto& stage : source.pipeline.previous) {
+      stage.load = fp.readl<u8>(1);
+      stage.rWrite = fp.readl<u32>(4);
+      stage.vWrite = fp.readl<u32>(4);
+    }
+    u32 words = fp.readl<u16>(2);
+    if(fp.end() || words > 1024) break;
+    for(u32 word : range(words)) source.words.append(fp.readl<u32>(4));
+    source.used = count - index;  //the file is stored in most recently used order
+    source.bytes = 0;
+    source.block = nullptr;
+    sources.append(source);
+  }
+  uses = max(uses, (u64)count);
+}
+
+auto RSP::Recompiler::saveCache() -> void {
+  trim();
+  if(!sources) return;
+  directory::create(location());
+  auto fp = file::open({location(), "rsp.bin"}, file::mode::write);
+  if(!fp) return;
+
+  fp.writes("ares-rsp");
+  fp.writel(CacheVersion, 4);
+  fp.writel(sources.size(), 4);
+  for(auto& source : sources) {
+    fp.writel(source.hashcode, 8);
+    fp.writel((u16)source.address, 2);
+    fp.writel((u8)source.pipeline.singleIssue, 1);
+    for(auto& stage : source.pipeline.previous) {
+      fp.writel((u8)stage.load, 1);
+      fp.writel(stage.rWrite, 4);
+      fp.writel(stage.vWrite, 4);
+    }
+    fp.writel(source.words.size(), 2);
+    for(auto word : source.words) fp.writel(word, 4);
+  }
+}
+
+auto RSP::Recompiler::emit(u12 address) -> Block* {
   pipeline = self.pipeline;
 
   auto block = (Block*)allocator.acquire(sizeof(Block));
-  beginFunction(3);
+  beginFunction(3, 3, 6);
 
   u12 start = address;
   bool hasBranched = 0;
@@ -701,6 +855,8 @@ auto RSP::Recompiler::emitVU(u32 instruction) -> bool {
 
   #define E  (instruction >> 21 & 15)
   #define DE (instruction >> 11 &  7)
+  if(emitVectorOp(instruction)) return 0;
+
   switch(instruction & 0x3f) {
 
   //VMULF Vd,Vs,Vt(e)
@@ -11,6 +11,7 @@ RSP rsp;
 #include "interpreter-scc.cpp"
 #include "interpreter-vpu.cpp"
 #include "recompiler.cpp"
+#include "recompiler-vpu.cpp"
 #include "debugger.cpp"
 #include "serialization.cpp"
 #include "disassembler.cpp"
@@ -23,6 +24,9 @@ auto RSP::load(Node::Object parent) -> void {
 }
 
 auto RSP::unload() -> void {
+  if constexpr(Accuracy::RSP::Recompiler) {
+    recompiler.saveCache();
+  }
   debugger.unload();
   dmem.reset();
   imem.reset();
@@ -147,6 +151,9 @@ auto RSP::power(bool reset) -> void {
     auto buffer = ares::Memory::FixedAllocator::get().tryAcquire(64_MiB);
     recompiler.allocator.resize(64_MiB, bump_allocator::executable, buffer);
     recompiler.reset();
+    if(!recompiler.sources) recompiler.loadCache();
+    recompiler.trim();
+    recompiler.retranslate();
   }
 
   if constexpr(Accuracy::RSP::SISD) {
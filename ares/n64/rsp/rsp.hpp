@@ -514,6 +514,18 @@ struct RSP : Thread, Memory::RCP<RSP> {
       u8* code;
       u12 size;
       Pipeline pipeline;  //state at *end* of block excepting taken branch stall
+      u64 used;           //lookup order, for least-recently-used eviction
+    };
+
+    //a block in position-independent form: the microcode it was translated from
+    struct Source {
+      u64 hashcode;
+      u12 address;
+      Pipeline pipeline;  //state at *start* of block
+      vector<u32> words;
+      u32 bytes;          //allocator space used by the translation
+      u64 used;
+      Block* block;       //nullptr when not currently translated
     };
 
     struct BlockHashPair {
@@ -528,6 +540,7 @@ struct RSP : Thread, Memory::RCP<RSP> {
     auto reset() -> void {
       context.fill();
       blocks.reset();
+      for(auto& source : sources) source.block = nullptr;
       dirty = 0;
     }
 
@@ -539,6 +552,16 @@ struct RSP : Thread, Memory::RCP<RSP> {
     auto hash(u12 address, u12 size) -> u64;
 
     auto block(u12 address) -> Block*;
+    auto remember(const Source& source) -> void;
+    auto translate(Source& source) -> bool;
+    auto trim() -> void;
+    auto retranslate() -> void;
+    auto evict() -> void;
+
+    static constexpr u32 CacheVersion = 1;
+    auto location() -> string;
+    auto loadCache() -> void;
+    auto saveCache() -> void;
 
     auto emit(u12 address) -> Block*;
     auto emitEXECUTE(u32 instruction) -> bool;
@@ -551,6 +574,17 @@ struct RSP : Thread, Memory::RCP<RSP> {
 
     auto isTerminal(u32 instruction) -> bool;
 
+    //recompiler-vpu.cpp
+    auto emitVectorOp(u32 instruction) -> bool;
+    auto emitVectorSIMD(u32 instruction) -> bool;
+    auto vload(u32 x, sljit_sw offset) -> void;
+    auto vstore(sljit_sw offset, u32 x) -> void;
+    #if defined(ARCHITECTURE_AMD64) && ARCHITECTURE_SUPPORTS_SSE4_1
+    auto emitVectorSSE(u32 instruction) -> bool;
+    auto vsse(u32 opcode, u32 x, u32 y) -> void;
+    auto vshift(u32 group, u32 x, u8 amount) -> void;
+    #endif
+
     static auto mask(u12 address, u12 size) -> u64 {
       //1 bit per 64 bytes
       u6 s = address >> 6;
@@ -566,6 +600,8 @@ struct RSP : Thread, Memory::RCP<RSP> {
     bump_allocator allocator;
     array<Block*[1024]> context;
     hashset<BlockHashPair> blocks;
+    vector<Source> sources;
+    u64 uses = 0;
     u64 dirty;
   } recompiler{*this};
 
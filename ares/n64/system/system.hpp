@@ -21,7 +21,7 @@ struct System {
   auto power(bool reset) -> void;
 
   //serialization.cpp
-  auto serialize(bool synchronize = true) -> serializer;
+  auto serialize(bool synchronize = true, serializer = {}) -> serializer;
   auto unserialize(serializer&) -> bool;
 
 private:
@@ -6,7 +6,7 @@ auto CPU::read(n1 upper, n1 lower, n24 address, n16 data) -> n16 {
     }
   }
 
-  if(auto result = platform->cheat(address)) return *result;
+  if(auto result = cheats.find(address)) return *result;
 
   //cartridge program ROM
   if(address <= 0x0fffff) {
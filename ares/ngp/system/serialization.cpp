@@ -1,8 +1,8 @@
 static const string SerializerVersion = "v131";
 
-auto System::serialize(bool synchronize) -> serializer {
+auto System::serialize(bool synchronize, serializer s) -> serializer {
   if(synchronize) scheduler.enter(Scheduler::Mode::Synchronize);
-  serializer s;
+  s.setWriting();
 
   u32  signature = SerializerSignature;
   char version[16] = {};
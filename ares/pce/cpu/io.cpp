@@ -1,5 +1,5 @@
 auto CPU::read(n8 bank, n13 address) -> n8 {
-  if(auto result = platform->cheat(bank.bit(0,1) << 13 | address)) return *result;
+  if(auto result = cheats.find(bank.bit(0,1) << 13 | address)) return *result;
 
   n8 data = 0xff;
 
@@ -17,7 +17,7 @@ struct Accuracy {
   };
 
   struct GPU {
-    //performs GPU primitive rendering on a separate thread
+    //performs GPU primitive rendering on a pool of threads
     static constexpr bool Threaded = 1 & !Reference;
   };
 };
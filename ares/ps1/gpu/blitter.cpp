@@ -55,6 +55,9 @@ auto GPU::Blitter::queue() -> void {
   sx = self.io.displayStartX;
   sy = self.io.displayStartY;
 
+  //primitives still being drawn to the displayed area must complete before it is read
+  self.renderer.synchronize(Renderer::Area::wrap(sx, sy, depth ? tw * 3 / 2 + 2 : tw, th), false);
+
   self.screen->setViewport(0, 0, width, height);
   self.screen->frame();
 }
@@ -62,7 +65,6 @@ auto GPU::Blitter::queue() -> void {
 auto GPU::Blitter::refresh() -> void {
   if(blank) return;
 
-  self.vram.mutex.lock();
   auto output = self.screen->pixels(1).data();
 
   //15bpp
@@ -93,7 +95,6 @@ auto GPU::Blitter::refresh() -> void {
     }
   }
 
-  self.vram.mutex.unlock();
 }
 
 auto GPU::Blitter::power() -> void {
@@ -8,7 +8,6 @@ auto GPU::readGP0() -> u32 {
   }
 
   if(io.mode == Mode::CopyFromVRAM) {
-    vram.mutex.lock();
     for(u32 loop : range(2)) {
       n10 x = io.copy.x + io.copy.px;
       n9  y = io.copy.y + io.copy.py;
@@ -22,7 +21,6 @@ auto GPU::readGP0() -> u32 {
         }
       }
     }
-    vram.mutex.unlock();
     return data;
   }
 
@@ -32,7 +30,6 @@ auto GPU::readGP0() -> u32 {
 
 auto GPU::writeGP0(u32 value, bool isThread) -> void {
   if(io.mode == Mode::CopyToVRAM) {
-    vram.mutex.lock();
     for(u32 loop : range(2)) {
       n10 x = io.copy.x + io.copy.px;
       n9  y = io.copy.y + io.copy.py;
@@ -50,7 +47,6 @@ auto GPU::writeGP0(u32 value, bool isThread) -> void {
         }
       }
     }
-    vram.mutex.unlock();
     return;
   }
 
@@ -388,6 +384,8 @@ auto GPU::writeGP0(u32 value, bool isThread) -> void {
     u16 targetY = queue.data[2].bit(16,31);
     u16 width   = queue.data[3].bit( 0,15);
     u16 height  = queue.data[3].bit(16,31);
+    renderer.synchronize(Renderer::Area::wrap(sourceX, sourceY, width, height), false);
+    renderer.synchronize(Renderer::Area::wrap(targetX, targetY, width, height), true);
     for(u32 y : range(height)) {
       for(u32 x : range(width)) {
         u16 pixel = vram2D[n9(y + sourceY) & 511][n10(x + sourceX) & 1023];
@@ -409,6 +407,7 @@ auto GPU::writeGP0(u32 value, bool isThread) -> void {
     io.copy.px     = 0;
     io.copy.py     = 0;
     io.mode        = Mode::CopyToVRAM;
+    renderer.synchronize(Renderer::Area::wrap(io.copy.x, io.copy.y, io.copy.width, io.copy.height), true);
     return queue.reset();
   }
 
@@ -422,6 +421,7 @@ auto GPU::writeGP0(u32 value, bool isThread) -> void {
     io.copy.px     = 0;
     io.copy.py     = 0;
     io.mode        = Mode::CopyFromVRAM;
+    renderer.synchronize(Renderer::Area::wrap(io.copy.x, io.copy.y, io.copy.width, io.copy.height), false);
     return queue.reset();
   }
 
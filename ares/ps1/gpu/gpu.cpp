@@ -137,6 +137,7 @@ auto GPU::power(bool reset) -> void {
   screen->power();
   refreshed = false;
 
+  renderer.power();
   vram.fill();
   display.dotclock = 0;
   display.width = 0;
@@ -151,7 +152,6 @@ auto GPU::power(bool reset) -> void {
   queue.gp1 = {};
 
   frame();
-  renderer.power();
   blitter.power();
 }
 
@@ -316,6 +316,9 @@ struct GPU : Thread, Memory::Interface {
     template<u32 Flags> auto cost(u32 pixels) const -> u32;
     auto execute() -> void;
 
+    //a threaded renderer draws each primitive once per band, skipping rows owned by other threads
+    auto owns(s32 y) const -> bool { return bands == 1 || (y & 511) / 8 % bands == band; }
+
     u32  command;
     u32  flags;
     bool dithering;
@@ -343,21 +346,59 @@ struct GPU : Thread, Memory::Interface {
     Vertex v2;
     Vertex v3;
     Size size;
+    u32  band = 0;
+    u32  bands = 1;
   };
 
 //unserialized:
-  //renderer.cpp
+  //renderer.cpp: primitives are recorded into a batch, which a pool of threads draws while emulation continues.
+  //each thread owns an interleaved set of 8-row bands of VRAM, so primitives remain in order within every band.
   struct Renderer {
     GPU& self;
     Renderer(GPU& self) : self(self) {}
 
+    static constexpr u32 Workers = 8;   //maximum number of rendering threads
+    static constexpr u32 Limit = 4096;  //primitives recorded before the batch is submitted
+
+    //an inclusive rectangle of VRAM
+    struct Area {
+      static auto wrap(s32 x, s32 y, s32 width, s32 height) -> Area;
+      auto overlaps(const Area& other) const -> bool;
+      auto contains(const Area& other) const -> bool;
+
+      s32 x0, y0, x1, y1;
+    };
+
+    struct Batch {
+      auto reset() -> void;
+      auto overlaps(Area area, bool write) const -> bool;
+
+      vector<Render> renders;
+      vector<Area> written;  //areas the primitives may draw to
+      vector<Area> read;     //texture pages and palettes the primitives may sample from
+    };
+
     auto queue(Render& render) -> void;
-    auto main(uintptr_t) -> void;
+    auto record(vector<Area>& areas, Area area) -> void;
+    auto submit() -> void;
+    auto wait() -> void;
+    auto finish() -> void;
+    auto synchronize(Area area, bool write) -> void;
+    auto main(uintptr_t band) -> void;
     auto kill() -> void;
     auto power() -> void;
 
-    nall::thread handle;
-    queue_spsc<Render[65536]> fifo;
+    nall::thread workers[Workers];
+    u32 threads = 0;
+    mutex lock;
+    condition_variable wake;
+    condition_variable done;
+    u32 generation = 0;
+    u32 running = 0;
+    bool quit = false;
+
+    Batch batches[2];  //one is recorded by the emulation thread while the other is drawn
+    u32 current = 0;   //index of the batch being recorded
   } renderer{*this};
 
   //blitter.cpp
@@ -126,6 +126,8 @@ auto GPU::Render::alpha(Color above, Color below) const -> Color {
 
 template<u32 Flags>
 auto GPU::Render::pixel(Point point, Color rgb, Point uv) -> void {
+  if(!owns(point.y)) return;
+
   Color above;
   bool transparent;
   bool maskBit = forceMaskBit;
@@ -276,15 +278,17 @@ auto GPU::Render::triangle() -> void {
     if constexpr(Flags & Shade) pr.x = pr.y, pg.x = pg.y, pb.x = pb.y;
     if constexpr(Flags & Texture) pu.x = pu.y, pv.x = pv.y;
 
-    for(vp.x = vmin.x; vp.x <= vmax.x; vp.x++) {
-      if((p0.x + bias[0] | p1.x + bias[1] | p2.x + bias[2]) >= 0) {
-        pixel<Flags | Dithering>(vp, Color::fromRGB(pr.x, pg.x, pb.x), {s32(pu.x), s32(pv.x)});
-        pixels++;
-      }
+    if(owns(vp.y)) {
+      for(vp.x = vmin.x; vp.x <= vmax.x; vp.x++) {
+        if((p0.x + bias[0] | p1.x + bias[1] | p2.x + bias[2]) >= 0) {
+          pixel<Flags | Dithering>(vp, Color::fromRGB(pr.x, pg.x, pb.x), {s32(pu.x), s32(pv.x)});
+          pixels++;
+        }
 
-      p0.x += d0.x, p1.x += d1.x, p2.x += d2.x;
-      if constexpr(Flags & Shade) pr.x += dr.x, pg.x += dg.x, pb.x += db.x;
-      if constexpr(Flags & Texture) pu.x += du.x, pv.x += dv.x;
+        p0.x += d0.x, p1.x += d1.x, p2.x += d2.x;
+        if constexpr(Flags & Shade) pr.x += dr.x, pg.x += dg.x, pb.x += db.x;
+        if constexpr(Flags & Texture) pu.x += du.x, pv.x += dv.x;
+      }
     }
 
     p0.y += d0.y, p1.y += d1.y, p2.y += d2.y;
@@ -315,6 +319,7 @@ template<u32 Flags>
 auto GPU::Render::fill() -> void {
   auto color = v0.to16();
   for(u32 y : range(size.h)) {
+    if(!owns(y + v0.y)) continue;
     for(u32 x : range(size.w)) {
       gpu.vram2D[y + v0.y & 511][x + v0.x & 1023] = color;
     }
@@ -419,37 +424,200 @@ auto GPU::Render::execute() -> void {
   }
 }
 
+auto GPU::Renderer::Area::wrap(s32 x, s32 y, s32 width, s32 height) -> Area {
+  x &= 1023, y &= 511;
+  //areas that wrap around the edges of VRAM are widened to span the entire axis
+  if(x + width  > 1024) x = 0, width  = 1024;
+  if(y + height >  512) y = 0, height =  512;
+  return {x, y, x + width - 1, y + height - 1};
+}
+
+auto GPU::Renderer::Area::overlaps(const Area& other) const -> bool {
+  return x0 <= other.x1 && other.x0 <= x1 && y0 <= other.y1 && other.y0 <= y1;
+}
+
+auto GPU::Renderer::Area::contains(const Area& other) const -> bool {
+  return x0 <= other.x0 && other.x1 <= x1 && y0 <= other.y0 && other.y1 <= y1;
+}
+
+auto GPU::Renderer::Batch::reset() -> void {
+  renders.resize(0);
+  written.resize(0);
+  read.resize(0);
+}
+
+//write accesses conflict with both reads and writes by the batch; read accesses only with its writes
+auto GPU::Renderer::Batch::overlaps(Area area, bool write) const -> bool {
+  for(auto& other : written) if(area.overlaps(other)) return true;
+  if(write) for(auto& other : read) if(area.overlaps(other)) return true;
+  return false;
+}
+
 auto GPU::Renderer::queue(Render& render) -> void {
-  if constexpr(Accuracy::GPU::Threaded) {
-    fifo.await_write(render);
-  } else if constexpr(true) {
-    render.execute();
+  if(!threads) return render.execute();
+
+  Area target;
+  if(render.command == 0x02) {
+    //fill ignores the drawing area
+    if(!render.size.w || !render.size.h) return;
+    target = Area::wrap(render.v0.x, render.v0.y, render.size.w, render.size.h);
+  } else {
+    target.x0 = render.drawingAreaOriginX1;
+    target.y0 = render.drawingAreaOriginY1;
+    target.x1 = render.drawingAreaOriginX2;
+    target.y1 = render.drawingAreaOriginY2;
+    if(target.x0 > target.x1 || target.y0 > target.y1) return;
+  }
+
+  bool polygon = render.command >= 0x20 && render.command <= 0x3f;
+  bool line = render.command >= 0x40 && render.command <= 0x5f;
+  bool rectangle = render.command >= 0x60 && render.command <= 0x7f;
+
+  //narrow the drawing area to the bounds of the primitive
+  if(polygon || line || rectangle) {
+    Point points[4] = {render.v0, render.v1, render.v2, render.v3};
+    u32 count = polygon ? (render.command & 0x08 ? 4 : 3) : 2;
+    if(rectangle) points[1] = {render.v0.x + render.size.w, render.v0.y + render.size.h};
+    Area bounds{+2048, +2048, -2048, -2048};
+    for(u32 index : range(count)) {
+      s32 x = points[index].x + render.drawingAreaOffsetX;
+      s32 y = points[index].y + render.drawingAreaOffsetY;
+      //lines are clamped to the drawing area rather than clipped
+      if(line) x = std::clamp(x, target.x0, target.x1), y = std::clamp(y, target.y0, target.y1);
+      bounds.x0 = min(bounds.x0, x), bounds.y0 = min(bounds.y0, y);
+      bounds.x1 = max(bounds.x1, x), bounds.y1 = max(bounds.y1, y);
+    }
+    target.x0 = max(target.x0, bounds.x0), target.y0 = max(target.y0, bounds.y0);
+    target.x1 = min(target.x1, bounds.x1), target.y1 = min(target.y1, bounds.y1);
+    if(target.x0 > target.x1 || target.y0 > target.y1) return;
+  }
+  //the drawing area may extend past the bottom of VRAM, where drawing wraps around
+  if(render.command != 0x02) {
+    target = Area::wrap(target.x0, target.y0, target.x1 - target.x0 + 1, target.y1 - target.y0 + 1);
   }
+
+  maybe<Area> page;
+  maybe<Area> palette;
+  if((polygon || rectangle) && render.command & 0x04 && render.textureDepth <= 2) {
+    page = Area::wrap(render.texturePageBaseX, render.texturePageBaseY, 64 << render.textureDepth, 256);
+    if(render.textureDepth <= 1) {
+      palette = Area::wrap(render.texturePaletteX, render.texturePaletteY, render.textureDepth ? 256 : 16, 1);
+    }
+  }
+
+  //a primitive that samples from its own target would see texels drawn by other threads out of order,
+  //so it is drawn by the emulation thread once all preceding primitives have been.
+  if(page && page->overlaps(target) || palette && palette->overlaps(target)) {
+    finish();
+    return render.execute();
+  }
+
+  //a thread may sample or overwrite texels in another thread's bands: such primitives start a new batch,
+  //which is not drawn until every primitive in the current batch has been.
+  auto& batch = batches[current];
+  bool hazard = false;
+  for(auto& area : batch.read) hazard |= target.overlaps(area);
+  if(page) for(auto& area : batch.written) hazard |= page->overlaps(area);
+  if(palette) for(auto& area : batch.written) hazard |= palette->overlaps(area);
+  if(hazard || batch.renders.size() >= Limit) submit();
+
+  auto& next = batches[current];
+  next.renders.append(render);
+  record(next.written, target);
+  if(page) record(next.read, *page);
+  if(palette) record(next.read, *palette);
+}
+
+auto GPU::Renderer::record(vector<Area>& areas, Area area) -> void {
+  for(auto& other : areas) if(other.contains(area)) return;
+  if(areas.size() < 16) return areas.append(area);
+
+  //too many distinct areas: keep their bounding rectangle instead
+  for(auto& other : areas) {
+    area.x0 = min(area.x0, other.x0);
+    area.y0 = min(area.y0, other.y0);
+    area.x1 = max(area.x1, other.x1);
+    area.y1 = max(area.y1, other.y1);
+  }
+  areas.resize(0);
+  areas.append(area);
+}
+
+//starts drawing the recorded batch once the previous one has completed
+auto GPU::Renderer::submit() -> void {
+  if(!batches[current].renders) return;
+  wait();
+  lock.lock();
+  current ^= 1;
+  running = threads;
+  generation++;
+  lock.unlock();
+  batches[current].reset();
+  wake.notify_all();
+}
+
+auto GPU::Renderer::wait() -> void {
+  if(!threads) return;
+  unique_lock<mutex> guard(lock);
+  done.wait(guard, [&] { return running == 0; });
 }
 
-auto GPU::Renderer::main(uintptr_t) -> void {
+auto GPU::Renderer::finish() -> void {
+  submit();
+  wait();
+}
+
+//called before the emulation thread accesses VRAM directly
+auto GPU::Renderer::synchronize(Area area, bool write) -> void {
+  if(!threads) return;
+  if(batches[current].overlaps(area, write) || batches[current ^ 1].overlaps(area, write)) finish();
+}
+
+auto GPU::Renderer::main(uintptr_t band) -> void {
+  u32 seen = 0;
   while(true) {
-    auto render = fifo.await_read();
-    self.vram.mutex.lock();
-    render.execute();
-    self.vram.mutex.unlock();
-    if(render.command == 0x100) thread::exit();
+    unique_lock<mutex> guard(lock);
+    wake.wait(guard, [&] { return generation != seen; });
+    seen = generation;
+    if(quit) return;
+    auto& batch = batches[current ^ 1];
+    guard.unlock();
+    for(auto& primitive : batch.renders) {
+      //primitives modify their vertices while drawing, so each thread draws its own copy
+      Render render = primitive;
+      render.band = band;
+      render.bands = threads;
+      render.execute();
+    }
+    guard.lock();
+    if(--running == 0) done.notify_one();
   }
 }
 
 auto GPU::Renderer::kill() -> void {
-  if constexpr(Accuracy::GPU::Threaded) {
-    Render kill;
-    kill.command = 0x100;
-    queue(kill);
-    handle.join();
-  }
+  if(!threads) return;
+  wait();
+  lock.lock();
+  quit = true;
+  generation++;
+  lock.unlock();
+  wake.notify_all();
+  for(u32 index : range(threads)) workers[index].join();
+  threads = 0;
 }
 
 auto GPU::Renderer::power() -> void {
+  kill();
+  batches[0].reset();
+  batches[1].reset();
+  current = 0;
+  quit = false;
   if constexpr(Accuracy::GPU::Threaded) {
-    kill();
-    fifo.flush();
-    handle = thread::create({&GPU::Renderer::main, &self.renderer});
+    //at least one thread is always used, so that rendering overlaps with emulation
+    u32 processors = std::thread::hardware_concurrency();
+    threads = max(1u, min(processors ? processors - 1 : 0, Workers));
+  }
+  for(u32 index : range(threads)) {
+    workers[index] = thread::create({&GPU::Renderer::main, this}, index);
   }
 }
@@ -1,6 +1,9 @@
 auto GPU::serialize(serializer& s) -> void {
   Thread::serialize(s);
 
+  //draw any queued primitives before VRAM is saved or replaced
+  renderer.finish();
+
   s(vram);
 
   s(display.dotclock);
@@ -73,6 +76,4 @@ auto GPU::serialize(serializer& s) -> void {
   s(queue.gp1.data);
   s(queue.gp1.counterX);
   s(queue.gp1.counterY);
-
-  renderer.power();
 }
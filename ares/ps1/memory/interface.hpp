@@ -39,6 +39,4 @@ struct Interface {
     u32 half = 0;
     u32 word = 0;
   } waitStates;
-
-  std::mutex mutex;
 };
@@ -1,6 +1,7 @@
 #pragma once
 //started: 2020-06-17
 
+#include <thread>
 #include <ares/ares.hpp>
 #include <nall/hashset.hpp>
 #include <nall/recompiler/generic/generic.hpp>
@@ -92,7 +92,10 @@ auto SPU::sample() -> void {
   captureVolume(2, sclamp<16>(voice[1].adsr.lastVolume));
   captureVolume(3, sclamp<16>(voice[3].adsr.lastVolume));
   capture.address += 2;
-  stream->frame(lsum / 32768.0, rsum / 32768.0);
+  if(runAhead()) return;
+  buffer[buffered++] = lsum / 32768.0;
+  buffer[buffered++] = rsum / 32768.0;
+  if(buffered == 2 * 256) stream->write(buffer, 256), buffered = 0;
 }
 
 auto SPU::step(u32 clocks) -> void {
@@ -103,6 +106,7 @@ auto SPU::power(bool reset) -> void {
   Thread::reset();
   Memory::Interface::setWaitStates(18, 18, 45);
   ram.fill();
+  buffered = 0;
 
   master = {};
   noise.step = 0;
@@ -5,6 +5,10 @@ struct SPU : Thread, Memory::Interface {
   Node::Audio::Stream stream;
   Memory::Writable ram;
 
+  //frames are collected here and written to the stream in blocks
+  f64 buffer[2 * 256];
+  u32 buffered = 0;
+
   struct Debugger {
     //debugger.cpp
     auto load(Node::Object) -> void;
@@ -1,7 +1,7 @@
 static const string SerializerVersion = "v131";
 
-auto System::serialize(bool synchronize) -> serializer {
-  serializer s;
+auto System::serialize(bool synchronize, serializer s) -> serializer {
+  s.setWriting();
 
   u32  signature = SerializerSignature;
   char version[16] = {};
@@ -77,7 +77,14 @@ auto Cartridge::loadMap(Markup::Node map, T& memory) -> n32 {
   auto base = map["base"].natural();
   auto mask = map["mask"].natural();
   if(size == 0) size = memory.size();
-  return bus.map({&T::read, &memory}, {&T::write, &memory}, address, size, base, mask);
+  auto id = bus.map({&T::read, &memory}, {&T::write, &memory}, address, size, base, mask);
+  if constexpr(is_same_v<T, ReadableMemory> || is_same_v<T, ProtectableMemory>) {
+    bus.direct(id, memory.data(), memory.size(), false);
+  }
+  if constexpr(is_same_v<T, WritableMemory>) {
+    bus.direct(id, memory.data(), memory.size(), true);
+  }
+  return id;
 }
 
 auto Cartridge::loadMap(
@@ -66,8 +66,8 @@ auto CPU::map() -> void {
 
   reader = {&CPU::readRAM, this};
   writer = {&CPU::writeRAM, this};
-  bus.map(reader, writer, "00-3f,80-bf:0000-1fff", 0x2000);
-  bus.map(reader, writer, "7e-7f:0000-ffff", 0x20000);
+  bus.direct(bus.map(reader, writer, "00-3f,80-bf:0000-1fff", 0x2000), wram, sizeof(wram), true);
+  bus.direct(bus.map(reader, writer, "7e-7f:0000-ffff", 0x20000), wram, sizeof(wram), true);
 
   reader = {&CPU::readAPU, this};
   writer = {&CPU::writeAPU, this};
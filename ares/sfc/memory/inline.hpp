@@ -25,11 +25,23 @@ alwaysinline auto Bus::reduce(u32 address, u32 mask) -> u32 {
 
 alwaysinline auto Bus::read(n24 address, n8 data) -> n8 {
   if(!(address & 0x40e000)) address = 0x7e0000 | (address & 0x1fff);  //de-mirror WRAM
-  if(auto result = platform->cheat(address)) return *result;
+  if(auto result = cheats.find(address)) return *result;
 
-  return reader[lookup[address]](target[address], data);
+  auto& page = pages[address >> 8];
+  if(page.data) return page.data[address & 0xff];
+  if(page.table) {
+    auto& table = tables[page.table];
+    return reader[table.id[address & 0xff]](table.target[address & 0xff], data);
+  }
+  return reader[page.id](page.offset + (address & 0xff), data);
 }
 
 alwaysinline auto Bus::write(n24 address, n8 data) -> void {
-  return writer[lookup[address]](target[address], data);
+  auto& page = pages[address >> 8];
+  if(page.writable) return (void)(page.data[address & 0xff] = data);
+  if(page.table) {
+    auto& table = tables[page.table];
+    return writer[table.id[address & 0xff]](table.target[address & 0xff], data);
+  }
+  return writer[page.id](page.offset + (address & 0xff), data);
 }
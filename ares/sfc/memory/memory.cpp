@@ -5,8 +5,7 @@ namespace ares::SuperFamicom {
 Bus bus;
 
 Bus::~Bus() {
-  if(lookup) delete[] lookup;
-  if(target) delete[] target;
+  if(pages) delete[] pages;
 }
 
 auto Bus::reset() -> void {
@@ -14,13 +13,16 @@ auto Bus::reset() -> void {
     reader[id].reset();
     writer[id].reset();
     counter[id] = 0;
+    memory[id] = nullptr;
+    capacity[id] = 0;
+    writable[id] = false;
   }
 
-  if(lookup) delete[] lookup;
-  if(target) delete[] target;
-
-  lookup = new n8 [16_MiB]();
-  target = new n32[16_MiB]();
+  if(pages) delete[] pages;
+  pages = new Page[64_KiB]();
+  tables.reset();
+  tables.resize(1);  //index 0 means the page has no table
+  spare.reset();
 
   reader[0] = [](n24, n8 data) -> n8 { return data; };
   writer[0] = [](n24, n8) -> void {};
@@ -41,6 +43,9 @@ auto Bus::map(
 
   reader[id] = read;
   writer[id] = write;
+  memory[id] = nullptr;
+  capacity[id] = 0;
+  writable[id] = false;
 
   auto p = addr.split(":", 1L);
   auto banks = p(0).split(",");
@@ -56,19 +61,12 @@ auto Bus::map(
 
       for(u32 bank = bankLo; bank <= bankHi; bank++) {
         for(u32 addr = addrLo; addr <= addrHi; addr++) {
-          u32 pid = lookup[bank << 16 | addr];
-          if(pid && --counter[pid] == 0) {
-            reader[pid].reset();
-            writer[pid].reset();
-          }
-
           u32 offset = reduce(bank << 16 | addr, mask);
           if(size) base = mirror(base, size);
           if(size) offset = base + mirror(offset, size - base);
-          lookup[bank << 16 | addr] = id;
-          target[bank << 16 | addr] = offset;
-          counter[id]++;
+          assign(bank << 16 | addr, id, offset);
         }
+        for(u32 page = addrLo >> 8; page <= addrHi >> 8; page++) compact(bank << 8 | page);
       }
     }
   }
@@ -91,18 +89,88 @@ auto Bus::unmap(const string& addr) -> void {
 
       for(u32 bank = bankLo; bank <= bankHi; bank++) {
         for(u32 addr = addrLo; addr <= addrHi; addr++) {
-          u32 pid = lookup[bank << 16 | addr];
-          if(pid && --counter[pid] == 0) {
-            reader[pid].reset();
-            writer[pid].reset();
-          }
-
-          lookup[bank << 16 | addr] = 0;
-          target[bank << 16 | addr] = 0;
+          assign(bank << 16 | addr, 0, 0);
         }
+        for(u32 page = addrLo >> 8; page <= addrHi >> 8; page++) compact(bank << 8 | page);
       }
     }
   }
 }
 
+//declares that a mapping is plain memory, so that its pages can be accessed through host pointers.
+//writable mappings must have no side effects on write beyond storing the value.
+auto Bus::direct(u32 id, n8* data, u32 size, bool writable) -> void {
+  if(!id) return;
+  memory[id] = data;
+  capacity[id] = size;
+  this->writable[id] = writable;
+  for(u32 index : range(64_KiB)) {
+    if(!pages[index].table && pages[index].id == id) compact(index);
+  }
+}
+
+auto Bus::assign(u32 address, u32 id, u32 target) -> void {
+  auto& page = pages[address >> 8];
+  u32 byte = address & 0xff;
+
+  if(!page.table) {
+    if(page.id == id && (!id || page.offset + byte == target)) return;
+
+    //the page no longer maps linearly onto one handler: give it a table
+    if(spare) {
+      page.table = spare.takeLast();
+    } else {
+      page.table = tables.size();
+      tables.resize(tables.size() + 1);
+    }
+    auto& table = tables[page.table];
+    for(u32 n : range(256)) {
+      table.id[n] = page.id;
+      table.target[n] = page.offset + n;
+    }
+    page.data = nullptr;
+    page.writable = false;
+  }
+
+  auto& table = tables[page.table];
+  u32 pid = table.id[byte];
+  if(pid && --counter[pid] == 0) release(pid);
+  table.id[byte] = id;
+  table.target[byte] = target;
+  if(id) counter[id]++;
+}
+
+//turns a table page back into a linear page when possible, and refreshes its host pointer
+auto Bus::compact(u32 index) -> void {
+  auto& page = pages[index];
+
+  if(page.table) {
+    auto& table = tables[page.table];
+    u32 id = table.id[0];
+    for(u32 n : range(256)) {
+      if(table.id[n] != id) return;
+      if(id && table.target[n] != table.target[0] + n) return;
+    }
+    spare.append(page.table);
+    page.table = 0;
+    page.id = id;
+    page.offset = id ? table.target[0] : 0;
+  }
+
+  page.data = nullptr;
+  page.writable = false;
+  if(memory[page.id] && page.offset + 256 <= capacity[page.id]) {
+    page.data = memory[page.id] + page.offset;
+    page.writable = writable[page.id];
+  }
+}
+
+auto Bus::release(u32 id) -> void {
+  reader[id].reset();
+  writer[id].reset();
+  memory[id] = nullptr;
+  capacity[id] = 0;
+  writable[id] = false;
+}
+
 }
@@ -41,14 +41,40 @@ struct Bus {
     const string& address, u32 size = 0, u32 base = 0, u32 mask = 0
   ) -> u32;
   auto unmap(const string& address) -> void;
+  auto direct(u32 id, n8* data, u32 size, bool writable) -> void;
 
 private:
-  n8*  lookup = nullptr;
-  n32* target = nullptr;
+  //the address space is split into 256-byte pages.
+  //a page served by one handler with a linear target is described by id and offset alone;
+  //if that handler is plain memory (see direct), data points into it and bypasses the handler.
+  //pages shared by several handlers, or mirrored non-linearly, use a per-byte table instead.
+  struct Page {
+    n8*  data = nullptr;
+    u32  offset = 0;
+    u16  table = 0;
+    u8   id = 0;
+    bool writable = 0;
+  };
+
+  struct Table {
+    u8  id[256];
+    u32 target[256];
+  };
+
+  auto assign(u32 address, u32 id, u32 target) -> void;
+  auto compact(u32 index) -> void;
+  auto release(u32 id) -> void;
+
+  Page* pages = nullptr;
+  vector<Table> tables;
+  vector<u16> spare;
 
   function<n8   (n24, n8)> reader[256];
   function<void (n24, n8)> writer[256];
   n24 counter[256];
+  n8* memory[256];
+  u32 capacity[256];
+  bool writable[256];
 };
 
 extern Bus bus;
@@ -26,6 +26,7 @@ alwaysinline auto PPU::writeVRAM(n1 byte, n8 data) -> void {
   if(!io.displayDisable && cpu.vcounter() < vdisp()) return;
   auto address = addressVRAM();
   vram[address].byte(byte) = data;
+  if(renderer.active) renderer.write(address);
 }
 
 alwaysinline auto PPU::readOAM(n10 address) -> n8 {
@@ -150,6 +151,7 @@ auto PPU::readIO(n24 address, n8 data) -> n8 {
 
   //STAT77
   case 0x213e: {
+    renderer.wait();
     ppu1.mdr.bit(0,3) = ppu1.version;
     ppu1.mdr.bit(5)   = 0;
     ppu1.mdr.bit(6)   = obj.io.rangeOver;
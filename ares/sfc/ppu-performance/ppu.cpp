@@ -15,6 +15,7 @@ PPU ppuPerformanceImpl;
 #include "object.cpp"
 #include "dac.cpp"
 #include "color.cpp"
+#include "renderer.cpp"
 #include "debugger.cpp"
 #include "serialization.cpp"
 
@@ -34,13 +35,17 @@ auto PPU::load(Node::Object parent) -> void {
     screen->resetPalette();
   });
   deepBlackBoost->setDynamic(true);
+
+  threadedRendering = node->append<Node::Setting::Boolean>("Threaded Rendering", std::thread::hardware_concurrency() > 1);
   debugger.load(node);
 }
 
 auto PPU::unload() -> void {
+  renderer.kill();
   debugger.unload(node);
   vramSize.reset();
   deepBlackBoost.reset();
+  threadedRendering.reset();
   screen->quit();
   node->remove(screen);
   screen.reset();
@@ -59,20 +64,17 @@ auto PPU::main() -> void {
     state.overscan   = io.overscan;
     obj.io.rangeOver = 0;
     obj.io.timeOver  = 0;
+    renderer.frame();
   }
 
   if(vcounter() && vcounter() < vdisp() && !runAhead()) {
     step(renderingCycle);
     mosaic.scanline();
-    dac.prepare();
-    if(!io.displayDisable) {
-      bg1.render();
-      bg2.render();
-      bg3.render();
-      bg4.render();
-      obj.render();
+    if(renderer.active) {
+      renderer.queue();
+    } else {
+      render();
     }
-    dac.render();
   }
 
   if(vcounter() == vdisp()) {
@@ -80,6 +82,7 @@ auto PPU::main() -> void {
   }
 
   if(vcounter() == 240) {
+    renderer.finish();
     if(state.interlace == 0) screen->setProgressive(1);
     if(state.interlace == 1) screen->setInterlace(field());
 
@@ -114,6 +117,18 @@ auto PPU::main() -> void {
   step(hperiod() - hcounter());
 }
 
+auto PPU::render() -> void {
+  dac.prepare();
+  if(!io.displayDisable) {
+    bg1.render();
+    bg2.render();
+    bg3.render();
+    bg4.render();
+    obj.render();
+  }
+  dac.render();
+}
+
 auto PPU::map() -> void {
   function<n8   (n24, n8)> reader{&PPU::readIO, this};
   function<void (n24, n8)> writer{&PPU::writeIO, this};
@@ -149,6 +164,7 @@ auto PPU::power(bool reset) -> void {
   }
   
   updateVideoMode();
+  renderer.power();
 
   string title;
   for(u32 index : range(21)) {
@@ -4,6 +4,7 @@ struct PPU : PPUBase::Implementation, PPUcounter {
   Node::Object node;
   Node::Setting::Natural vramSize;
   Node::Setting::Boolean deepBlackBoost;
+  Node::Setting::Boolean threadedRendering;
 
   struct Debugger {
     PPU& self;
@@ -40,6 +41,7 @@ struct PPU : PPUBase::Implementation, PPUcounter {
   auto main() -> void;
   auto map() -> void override;
   auto power(bool reset) -> void override;
+  auto render() -> void;
   auto draw(u32* output) -> void;
 
   //io.cpp
@@ -395,6 +397,71 @@ struct PPU : PPUBase::Implementation, PPUcounter {
     bool windowAbove[448];
     bool windowBelow[448];
   } dac{*this};
+
+  //renders scanlines on a worker thread while emulation continues.
+  //each line is queued with a snapshot of the state it reads; VRAM is copied once per frame,
+  //and any writes made while the frame is being rendered are logged and replayed in order.
+  struct Renderer {
+    PPU& self;
+    Renderer(PPU& self) : self(self) {}
+    ~Renderer() { kill(); }
+
+    static constexpr u32 Lines  = 256;   //more than the number of visible lines
+    static constexpr u32 Writes = 8192;  //VRAM writes logged before the worker is resynchronized
+
+    //renderer.cpp
+    auto power() -> void;
+    auto kill() -> void;
+    auto frame() -> void;
+    auto queue() -> void;
+    auto wait() -> void;
+    auto finish() -> void;
+    auto write(n16 address) -> void;
+    auto synchronize() -> void;
+    auto main(uintptr) -> void;
+    auto draw(u32 index) -> void;
+
+    struct Line {
+      PPUcounter counter;
+      State state;
+      PPU::IO io;
+      PPU::Mode7 mode7;
+      PPU::Window::IO window;
+      PPU::Background::IO background[4];
+      PPU::Window::Layer backgroundWindow[4];
+      n5 mosaicSize;
+      n5 mosaicCounter;
+      PPU::Object::IO object;
+      PPU::Window::Layer objectWindow;
+      PPU::OAM oam;
+      PPU::DAC::IO dac;
+      PPU::Window::Color dacWindow;
+      n15 cgram[256];
+      u32 writes;  //end of the VRAM write log
+    };
+
+    struct Write {
+      n16 address;
+      n16 data;
+    };
+
+    PPU* worker = nullptr;  //a second PPU that only ever holds the state of the line it is drawing
+    thread instance;
+    mutex lock;
+    condition_variable wake;
+    condition_variable done;
+    vector<Line> lines;
+    vector<Write> writes;
+    u32 submitted = 0;  //lines queued this frame
+    u32 rendered = 0;   //lines drawn this frame
+    u32 written = 0;    //VRAM writes logged this frame
+    u32 applied = 0;    //VRAM writes replayed by the worker
+    bool active = false;
+    bool sleeping = false;
+    bool quit = false;
+    n1 rangeOver;
+    n1 timeOver;
+  } renderer{*this};
 };
 
 extern PPU ppuPerformanceImpl;
@@ -0,0 +1,149 @@
+auto PPU::Renderer::power() -> void {
+  kill();
+  if(!self.threadedRendering || !self.threadedRendering->value()) return;
+
+  worker = new PPU;
+  worker->screen = self.screen;
+  lines.resize(Lines);
+  writes.resize(Writes);
+  quit = false;
+  instance = thread::create({&PPU::Renderer::main, this});
+}
+
+auto PPU::Renderer::kill() -> void {
+  if(!worker) return;
+  lock.lock();
+  quit = true;
+  lock.unlock();
+  wake.notify_one();
+  instance.join();
+  delete worker;
+  worker = nullptr;
+  lines.reset();
+  writes.reset();
+  active = false;
+  sleeping = false;
+}
+
+auto PPU::Renderer::main(uintptr) -> void {
+  while(true) {
+    unique_lock<mutex> guard(lock);
+    sleeping = true;
+    wake.wait(guard, [&] { return quit || rendered < submitted; });
+    sleeping = false;
+    if(quit) return;
+    u32 index = rendered;
+    guard.unlock();
+    draw(index);
+    guard.lock();
+    rangeOver |= worker->obj.io.rangeOver;
+    timeOver  |= worker->obj.io.timeOver;
+    if(++rendered == submitted) done.notify_one();
+  }
+}
+
+//called on the worker thread: brings the worker PPU up to date with the line, and then renders it
+auto PPU::Renderer::draw(u32 index) -> void {
+  auto& line = lines[index];
+  auto& ppu = *worker;
+
+  while(applied < line.writes) {
+    auto& write = writes[applied++];
+    ppu.vram.data[write.address] = write.data;
+  }
+
+  (PPUcounter&)ppu = line.counter;
+  ppu.state = line.state;
+  ppu.io = line.io;
+  ppu.mode7 = line.mode7;
+  ppu.window.io = line.window;
+  ppu.bg1.io = line.background[0], ppu.bg1.window = line.backgroundWindow[0];
+  ppu.bg2.io = line.background[1], ppu.bg2.window = line.backgroundWindow[1];
+  ppu.bg3.io = line.background[2], ppu.bg3.window = line.backgroundWindow[2];
+  ppu.bg4.io = line.background[3], ppu.bg4.window = line.backgroundWindow[3];
+  ppu.mosaic.size = line.mosaicSize;
+  ppu.mosaic.vcounter = line.mosaicCounter;
+  ppu.obj.io = line.object;
+  ppu.obj.window = line.objectWindow;
+  ppu.obj.oam = line.oam;
+  ppu.dac.io = line.dac;
+  ppu.dac.window = line.dacWindow;
+  memory::copy<n15>(ppu.dac.cgram, line.cgram, 256);
+  ppu.render();
+}
+
+//called at the start of each frame: hands the worker a fresh copy of VRAM
+auto PPU::Renderer::frame() -> void {
+  if(!worker || runAhead()) return;
+  lock_guard<mutex> guard(lock);
+  memory::copy<n16>(worker->vram.data, self.vram.data, self.vram.mask + 1);
+  worker->vram.mask = self.vram.mask;
+  submitted = 0;
+  rendered = 0;
+  written = 0;
+  applied = 0;
+  rangeOver = 0;
+  timeOver = 0;
+  active = true;
+}
+
+//snapshots the state the current line is rendered with
+auto PPU::Renderer::queue() -> void {
+  auto& line = lines[submitted];
+  line.counter = self;
+  line.state = self.state;
+  line.io = self.io;
+  line.mode7 = self.mode7;
+  line.window = self.window.io;
+  line.background[0] = self.bg1.io, line.backgroundWindow[0] = self.bg1.window;
+  line.background[1] = self.bg2.io, line.backgroundWindow[1] = self.bg2.window;
+  line.background[2] = self.bg3.io, line.backgroundWindow[2] = self.bg3.window;
+  line.background[3] = self.bg4.io, line.backgroundWindow[3] = self.bg4.window;
+  line.mosaicSize = self.mosaic.size;
+  line.mosaicCounter = self.mosaic.vcounter;
+  line.object = self.obj.io;
+  line.objectWindow = self.obj.window;
+  line.oam = self.obj.oam;
+  line.dac = self.dac.io;
+  line.dacWindow = self.dac.window;
+  memory::copy<n15>(line.cgram, self.dac.cgram, 256);
+  line.writes = written;
+
+  lock.lock();
+  submitted++;
+  bool wakeup = sleeping;
+  lock.unlock();
+  if(wakeup) wake.notify_one();
+}
+
+//blocks until every queued line has been rendered
+auto PPU::Renderer::wait() -> void {
+  if(!active) return;
+  unique_lock<mutex> guard(lock);
+  done.wait(guard, [&] { return rendered == submitted; });
+  self.obj.io.rangeOver |= rangeOver;
+  self.obj.io.timeOver  |= timeOver;
+}
+
+//called before the frame is output: no further lines will be queued until the next frame
+auto PPU::Renderer::finish() -> void {
+  wait();
+  active = false;
+}
+
+inline auto PPU::Renderer::write(n16 address) -> void {
+  if(written == Writes) synchronize();
+  address &= self.vram.mask;
+  writes[written++] = {address, self.vram.data[address]};
+}
+
+//replaces the log with a fresh copy of VRAM, once the worker is idle
+auto PPU::Renderer::synchronize() -> void {
+  if(!active) return;
+  wait();
+  lock_guard<mutex> guard(lock);
+  memory::copy<n16>(worker->vram.data, self.vram.data, self.vram.mask + 1);
+  worker->vram.mask = self.vram.mask;
+  written = 0;
+  applied = 0;
+}
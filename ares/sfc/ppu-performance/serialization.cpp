@@ -1,4 +1,5 @@
 auto PPU::serialize(serializer& s) -> void {
+  renderer.wait();
   Thread::serialize(s);
   PPUcounter::serialize(s);
 
@@ -66,6 +67,8 @@ auto PPU::serialize(serializer& s) -> void {
   s(bg4);
   s(obj);
   s(dac);
+
+  if(s.reading()) renderer.synchronize();
 }
 
 auto PPU::Window::Layer::serialize(serializer& s) -> void {
@@ -1,6 +1,7 @@
 #pragma once
 //started: 2004-10-14
 
+#include <thread>
 #include <ares/ares.hpp>
 
 #include <component/processor/arm7tdmi/arm7tdmi.hpp>
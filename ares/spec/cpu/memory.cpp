@@ -1,5 +1,5 @@
 auto CPU::read(n16 address) -> n8 {
-  if(auto result = platform->cheat(address)) return *result;
+  if(auto result = cheats.find(address)) return *result;
 
   if (address < 0x4000) {
     if (expansionPort.connected() && expansionPort.romcs()) {
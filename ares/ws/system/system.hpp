@@ -94,7 +94,7 @@ struct System : IO {
   auto writeIO(n16 address, n8 data) -> void override;
 
   //serialization.cpp
-  auto serialize(bool synchronize) -> serializer;
+  auto serialize(bool synchronize, serializer = {}) -> serializer;
   auto unserialize(serializer&) -> bool;
 
   struct Information {
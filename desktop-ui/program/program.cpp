@@ -78,16 +78,22 @@ auto Program::main() -> void {
   nall::GDB::server.updateLoop();
 
   program.requestFrameAdvance = false;
-  if(!runAhead || fastForwarding || rewinding) {
+  if(!runAhead.enabled || fastForwarding || rewinding) {
     emulator->root->run();
   } else {
     ares::setRunAhead(true);
     emulator->root->run();
-    auto state = emulator->root->serialize(false);
+    u64 saveStart = chrono::nanosecond();
+    emulator->root->serialize(runAhead.snapshot, false);
+    runAhead.saveTime += chrono::nanosecond() - saveStart;
+    for(u32 frame : range(1, runAhead.frames)) emulator->root->run();
     ares::setRunAhead(false);
     emulator->root->run();
-    state.setReading();
-    emulator->root->unserialize(state);
+    u64 restoreStart = chrono::nanosecond();
+    runAhead.snapshot.setReading();
+    emulator->root->unserialize(runAhead.snapshot);
+    runAhead.restoreTime += chrono::nanosecond() - restoreStart;
+    runAhead.samples++;
   }
 
   nall::GDB::server.updateLoop();
@@ -13,7 +13,6 @@ struct Program : ares::Platform {
   auto video(ares::Node::Video::Screen, const u32* data, u32 pitch, u32 width, u32 height) -> void override;
   auto audio(ares::Node::Audio::Stream) -> void override;
   auto input(ares::Node::Input::Input) -> void override;
-  auto cheat(u32 address) -> maybe<u32> override;
 
   //load.cpp
   auto identify(const string& filename) -> shared_pointer<Emulator>;
@@ -67,7 +66,6 @@ struct Program : ares::Platform {
   bool paused = false;
   bool fastForwarding = false;
   bool rewinding = false;
-  bool runAhead = false;
   bool requestFrameAdvance = false;
   bool requestScreenshot = false;
   bool keyboardCaptured = false;
@@ -77,11 +75,39 @@ struct Program : ares::Platform {
     u32 undoSlot = 1;
   } state;
 
+  //program.cpp
+  struct RunAhead {
+    bool enabled = false;
+    u32 frames = 1;       //number of frames to run ahead of the displayed frame
+    serializer snapshot;  //reused every frame, so that saving states does not allocate
+    u64 saveTime = 0;     //nanoseconds spent saving states since the last status update
+    u64 restoreTime = 0;  //nanoseconds spent restoring states since the last status update
+    u32 samples = 0;
+  } runAhead;
+
   //rewind.cpp
+  //history is stored as the most recent state in full, plus a ring buffer of reverse deltas:
+  //each delta transforms a state into the one captured before it, and is only decoded when rewinding.
   struct Rewind {
     enum class Mode : u32 { Playing, Rewinding } mode = Mode::Playing;
-    vector<serializer> history;
-    u32 length = 0;
+    struct Delta {
+      u32 offset = 0;  //position of the encoded delta inside buffer
+      u32 length = 0;  //length of the encoded delta in bytes
+      u32 size = 0;    //size of the state this delta reconstructs
+    };
+    auto push(const u8* data, u32 size) -> void;
+    auto pop() -> bool;
+    auto encode(const u8* data, u32 size) -> void;
+    auto decode(const Delta&) -> void;
+
+    vector<u8> buffer;     //preallocated ring buffer of encoded deltas
+    vector<Delta> deltas;  //circular list of deltas stored in buffer
+    u32 first = 0;         //index of the oldest delta
+    u32 count = 0;
+    vector<u8> current;    //most recent (or most recently restored) state
+    vector<u8> scratch;    //encoder output
+    bool restored = false;
+    u32 budget = 0;
     u32 frequency = 0;
     u32 counter = 0;
   } rewind;
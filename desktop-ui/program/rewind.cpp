@@ -1,13 +1,134 @@
+//deltas are a sequence of (skip, length) varint pairs, each followed by length bytes of the older state.
+//bytes that are skipped over are identical in both states, and so are taken from the newer state.
+
+auto Program::Rewind::push(const u8* data, u32 size) -> void {
+  if(current && deltas) {
+    encode(data, size);
+
+    u32 length = scratch.size();
+    if(length > buffer.size()) {
+      //delta cannot fit in the history at all: the older states are no longer reachable
+      first = 0;
+      count = 0;
+    } else {
+      u32 offset = 0;
+      if(count) {
+        auto& newest = deltas[(first + count - 1) % deltas.size()];
+        offset = newest.offset + newest.length;
+      }
+      if(offset + length > buffer.size()) {
+        //wrap around: discard the deltas stored past the wrap point, which are the oldest
+        while(count && deltas[first].offset >= offset) first = (first + 1) % deltas.size(), count--;
+        offset = 0;
+      }
+      while(count) {
+        auto& oldest = deltas[first];
+        if(oldest.offset >= offset + length || oldest.offset + oldest.length <= offset) break;
+        first = (first + 1) % deltas.size(), count--;
+      }
+      if(count == deltas.size()) first = (first + 1) % deltas.size(), count--;
+
+      memory::copy(buffer.data() + offset, scratch.data(), length);
+      deltas[(first + count++) % deltas.size()] = {offset, length, (u32)current.size()};
+    }
+  }
+
+  current.reallocate(size);
+  memory::copy(current.data(), data, size);
+  restored = false;
+}
+
+auto Program::Rewind::pop() -> bool {
+  if(!count) return false;
+  decode(deltas[(first + --count) % deltas.size()]);
+  return true;
+}
+
+//builds the delta that transforms {data, size} back into the current state
+auto Program::Rewind::encode(const u8* data, u32 size) -> void {
+  scratch.reallocate(0);
+  auto varint = [&](u32 value) {
+    while(value >= 0x80) scratch.append(0x80 | (value & 0x7f)), value >>= 7;
+    scratch.append(value);
+  };
+
+  const u8* older = current.data();
+  u32 length = current.size();
+  u32 common = min(length, size);
+
+  u32 offset = 0;
+  u32 base = 0;
+  while(offset < length) {
+    //find the next differing byte
+    while(offset + 8 <= common && !memory::compare(older + offset, data + offset, 8)) offset += 8;
+    while(offset < common && older[offset] == data[offset]) offset++;
+    if(offset >= length) break;
+
+    //extend the run until at least eight identical bytes follow it
+    u32 start = offset;
+    u32 same = 0;
+    while(offset < length && same < 8) {
+      if(offset < common && older[offset] == data[offset]) same++;
+      else same = 0;
+      offset++;
+    }
+    u32 end = offset - same;
+
+    varint(start - base);
+    varint(end - start);
+    u32 position = scratch.size();
+    scratch.reallocate(position + end - start);
+    memory::copy(scratch.data() + position, older + start, end - start);
+    base = end;
+  }
+}
+
+//transforms the current state into the state that was captured before it
+auto Program::Rewind::decode(const Delta& delta) -> void {
+  current.resize(delta.size);
+  const u8* input = buffer.data() + delta.offset;
+  const u8* end = input + delta.length;
+  auto varint = [&]() -> u32 {
+    u32 value = 0;
+    for(u32 shift = 0; input < end; shift += 7) {
+      u8 byte = *input++;
+      value |= (byte & 0x7f) << shift;
+      if(!(byte & 0x80)) break;
+    }
+    return value;
+  };
+
+  u32 offset = 0;
+  while(input < end) {
+    offset += varint();
+    u32 length = varint();
+    memory::copy(current.data() + offset, input, length);
+    input += length;
+    offset += length;
+  }
+}
+
 auto Program::rewindSetMode(Rewind::Mode mode) -> void {
   rewind.mode = mode;
   rewind.counter = 0;
+  rewind.restored = false;
 }
 
 auto Program::rewindReset() -> void {
   rewindSetMode(Rewind::Mode::Playing);
-  rewind.history.reset();
-  rewind.length = settings.rewind.length;
+  rewind.current.reset();
+  rewind.scratch.reset();
+  rewind.first = 0;
+  rewind.count = 0;
+  rewind.budget = settings.rewind.budget;
   rewind.frequency = settings.rewind.frequency;
+  if(settings.general.rewind && rewind.budget) {
+    rewind.buffer.reallocate(rewind.budget * 1_MiB);
+    rewind.deltas.resize(16_KiB);
+  } else {
+    rewind.buffer.reset();
+    rewind.deltas.reset();
+  }
 }
 
 auto Program::rewindRun() -> void {
@@ -16,21 +137,20 @@ auto Program::rewindRun() -> void {
   if(rewind.mode == Rewind::Mode::Playing) {
     if(++rewind.counter < rewind.frequency) return;
     rewind.counter = 0;
-    if(rewind.history.size() >= rewind.length) rewind.history.takeFirst();
     auto s = emulator->root->serialize(0);
-    rewind.history.append(s);
+    rewind.push(s.data(), s.size());
   }
 
   if(rewind.mode == Rewind::Mode::Rewinding) {
-    if(!rewind.history.size()) return rewindSetMode(Rewind::Mode::Playing);  //nothing left to rewind?
+    if(!rewind.current) return rewindSetMode(Rewind::Mode::Playing);  //nothing left to rewind?
     if(++rewind.counter < rewind.frequency / 5) return;  //rewind 5x faster than playing
     rewind.counter = 0;
-    auto s = rewind.history.takeLast();
-    s.setReading();
-    emulator->root->unserialize(s);
-    if(!rewind.history) {
+    if(rewind.restored && !rewind.pop()) {
       showMessage("Rewind history exhausted");
-      rewindReset();
+      return rewindReset();
     }
+    serializer s{rewind.current.data(), (u32)rewind.current.size()};
+    emulator->root->unserialize(s);
+    rewind.restored = true;
   }
 }
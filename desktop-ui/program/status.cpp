@@ -9,7 +9,16 @@ auto Program::updateMessage() -> void {
   }
 
   if(vblanksPerSecond) {
-    presentation.statusRight.setText({vblanksPerSecond(), " VPS"});
+    string text{vblanksPerSecond(), " VPS"};
+    if(runAhead.samples) {
+      //average time spent saving and restoring the run-ahead state, per frame
+      text.append(" (run-ahead: ", runAhead.saveTime / runAhead.samples / 1000, "us save, ");
+      text.append(runAhead.restoreTime / runAhead.samples / 1000, "us load)");
+      runAhead.saveTime = 0;
+      runAhead.restoreTime = 0;
+      runAhead.samples = 0;
+    }
+    presentation.statusRight.setText(text);
     vblanksPerSecond.reset();
   }
 
@@ -24,11 +24,13 @@ auto Program::paletteUpdate() -> void {
 }
 
 auto Program::runAheadUpdate() -> void {
-  runAhead = settings.general.runAhead;
+  runAhead.enabled = settings.general.runAhead;
+  runAhead.frames = max(1u, min(4u, settings.general.runAheadFrames));
+  runAhead.saveTime = 0;
+  runAhead.restoreTime = 0;
+  runAhead.samples = 0;
   if(!emulator) return;
-  if(emulator->name == "Game Boy Advance") runAhead = false;  //crashes immediately
-  if(emulator->name == "Nintendo 64") runAhead = false;  //too demanding
-  if(emulator->name == "PlayStation") runAhead = false;  //too demanding
+  if(emulator->name == "Game Boy Advance") runAhead.enabled = false;  //crashes immediately
 }
 
 auto Program::captureScreenshot(const u32* data, u32 pitch, u32 width, u32 height) -> void {
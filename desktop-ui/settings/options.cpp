@@ -15,8 +15,17 @@ auto OptionSettings::construct() -> void {
     settings.general.runAhead = runAhead.checked() && co_serializable();
     program.runAheadUpdate();
   });
+  for(u32 frames : range(1, 5)) {
+    ComboButtonItem item{&runAheadFrames};
+    item.setText({frames, frames == 1 ? " frame" : " frames"});
+    if(frames == settings.general.runAheadFrames) item.setSelected();
+  }
+  runAheadFrames.setEnabled(co_serializable()).onChange([&] {
+    settings.general.runAheadFrames = runAheadFrames.selected().offset() + 1;
+    program.runAheadUpdate();
+  });
   runAheadLayout.setAlignment(1).setPadding(12_sx, 0);
-      runAheadHint.setText("Removes one frame of input lag, but doubles system requirements").setFont(Font().setSize(7.0)).setForegroundColor(SystemColor::Sublabel);
+      runAheadHint.setText("Removes frames of input lag, but multiplies system requirements").setFont(Font().setSize(7.0)).setForegroundColor(SystemColor::Sublabel);
 
   autoSaveMemory.setText("Auto-Save Memory Periodically").setChecked(settings.general.autoSaveMemory).onToggle([&] {
     settings.general.autoSaveMemory = autoSaveMemory.checked();
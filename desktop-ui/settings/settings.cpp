@@ -98,10 +98,11 @@ auto Settings::process(bool load) -> void {
   bind(boolean, "General/ShowStatusBar", general.showStatusBar);
   bind(boolean, "General/Rewind", general.rewind);
   bind(boolean, "General/RunAhead", general.runAhead);
+  bind(natural, "General/RunAheadFrames", general.runAheadFrames);
   bind(boolean, "General/AutoSaveMemory", general.autoSaveMemory);
   bind(boolean, "General/HomebrewMode", general.homebrewMode);
 
-  bind(natural, "Rewind/Length", rewind.length);
+  bind(natural, "Rewind/Budget", rewind.budget);
   bind(natural, "Rewind/Frequency", rewind.frequency);
 
   bind(string,  "Paths/Home", paths.home);
@@ -64,12 +64,13 @@ struct Settings : Markup::Node {
     bool showStatusBar = true;
     bool rewind = false;
     bool runAhead = false;
+    u32 runAheadFrames = 1;
     bool autoSaveMemory = true;
     bool homebrewMode = false;
   } general;
 
   struct Rewind {
-    u32 length = 100;
+    u32 budget = 64;  //MiB
     u32 frequency = 10;
   } rewind;
 
@@ -240,6 +241,7 @@ struct OptionSettings : VerticalLayout {
       Label rewindHint{&rewindLayout, Size{~0, 0}};
     HorizontalLayout runAheadLayout{this, Size{~0, 0}, 5};
       CheckLabel runAhead{&runAheadLayout, Size{0, 0}, 5};
+      ComboButton runAheadFrames{&runAheadLayout, Size{0, 0}, 5};
       Label runAheadHint{&runAheadLayout, Size{~0, 0}};
     HorizontalLayout autoSaveMemoryLayout{this, Size{~0, 0}, 5};
       CheckLabel autoSaveMemory{&autoSaveMemoryLayout, Size{0, 0}, 5};
@@ -32,6 +32,7 @@ auto CheatEditor::construct() -> void {
           cheats.remove(*c);
           deleteButton.setEnabled(false);
           refresh();
+          synchronize();
         }
       }
     }
@@ -48,12 +49,14 @@ auto CheatEditor::construct() -> void {
     }
 
     refresh();
+    synchronize();
   });
 
   cheatList.onToggle([&](auto cell) {
     if(auto item = cheatList.selected()) {
       if(auto cheat = item.attribute<Cheat*>("cheat")) {
         cheat->enabled = cell.checked();
+        synchronize();
       }
     }
   });
@@ -89,6 +92,7 @@ auto CheatEditor::reload() -> void {
   }
 
   refresh();
+  synchronize();
 }
 
 auto CheatEditor::refresh() -> void {
@@ -134,14 +138,16 @@ auto CheatEditor::unload() -> void {
   }
 
   location = "";
+  ares::cheats.reset();
 }
 
-auto CheatEditor::find(uint address) -> maybe<u32> {
+//compiles the enabled cheats into the lookup structure that the emulated buses consult
+auto CheatEditor::synchronize() -> void {
+  ares::cheats.reset();
   for(auto& cheat : cheats) {
     if(!cheat.enabled) continue;
-    if(auto result = cheat.addressValuePairs.find(address)) return result();
+    for(auto& pair : cheat.addressValuePairs) ares::cheats.append(pair.key, pair.value);
   }
-  return nothing;
 }
 
 auto CheatEditor::setVisible(bool visible) -> CheatEditor& {
@@ -18,7 +18,7 @@ struct CheatEditor : VerticalLayout {
   auto refresh() -> void;
   auto setVisible(bool visible = true) -> CheatEditor&;
 
-  auto find(u32 address) -> maybe<u32>;
+  auto synchronize() -> void;
 
   Label cheatsLabel{this, Size{~0, 0}, 5};
   HorizontalLayout editLayout{this, Size{~0, 0}};
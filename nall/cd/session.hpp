@@ -330,6 +330,132 @@ struct Session {
     return data;
   }
 
+  //encodes the subchannel of a single sector, identical to the corresponding sector of encode(),
+  //so that subchannel data can be generated on demand rather than for the entire disc.
+  auto encode(s32 lba, array_span<u8> subchannel) const -> void {
+    for(u32 index : range(96)) subchannel[index] = 0x00;
+
+    //P is encoded one sector later than Q
+    s32 previous = lba - 1;
+    if(previous >= 0) {
+      u8 byte = 0x00;
+      if(previous >= leadOut.lba) {
+        s32 offset = previous - leadOut.lba;
+        if(offset >= 150) byte = (offset - 150) / (75 >> 1) & 1 ? 0x00 : 0xff;
+      } else if(previous >= leadOut.lba - 150) {
+        byte = 0xff;  //pre-lead-out
+      } else if(auto location = locate(previous)) {
+        byte = location->index == 0 ? 0xff : 0x00;
+      }
+      for(u32 index : range(12)) subchannel[index] = byte;
+    }
+
+    array_span<u8> q{&subchannel[12], 12};
+    if(lba < 0) {
+      if(lba < leadIn.lba) return;
+
+      //lead-in: the table of contents repeats, each entry three times
+      u32 present = 0;
+      for(u32 trackID : range(100)) present += (bool)tracks[trackID];
+      u32 entry = (lba - leadIn.lba) % (3 * (present + 3)) / 3;
+      auto msf = MSF(lba);
+      q[3] = BCD::encode(msf.minute);
+      q[4] = BCD::encode(msf.second);
+      q[5] = BCD::encode(msf.frame);
+      q[6] = 0x00;
+      if(entry < present) {
+        for(u32 trackID : range(100)) {
+          auto& track = tracks[trackID];
+          if(!track || entry--) continue;
+          q[0] = track.control << 4 | 1;
+          q[1] = 0x00;
+          q[2] = BCD::encode(trackID);
+          msf = MSF(track.indices[1].lba);
+          q[7] = BCD::encode(msf.minute);
+          q[8] = BCD::encode(msf.second);
+          q[9] = BCD::encode(msf.frame);
+          break;
+        }
+      } else if(entry == present + 0) {
+        q[0] = 0x01;
+        q[1] = 0x00;
+        q[2] = 0xa0;  //first track
+        q[7] = BCD::encode(firstTrack);
+        q[8] = 0x00;
+        q[9] = 0x00;
+      } else if(entry == present + 1) {
+        q[0] = 0x01;
+        q[1] = 0x00;
+        q[2] = 0xa1;  //last track
+        q[7] = BCD::encode(lastTrack);
+        q[8] = 0x00;
+        q[9] = 0x00;
+      } else {
+        q[0] = 0x01;
+        q[1] = 0x00;
+        q[2] = 0xa2;  //lead-out point
+        msf = MSF(leadOut.lba);
+        q[7] = BCD::encode(msf.minute);
+        q[8] = BCD::encode(msf.second);
+        q[9] = BCD::encode(msf.frame);
+      }
+    } else if(lba >= leadOut.lba) {
+      q[0] = 0x01;
+      q[1] = 0xaa;  //lead-out track#
+      q[2] = 0x01;  //lead-out index#
+      auto msf = MSF(lba - leadOut.lba);
+      q[3] = BCD::encode(msf.minute);
+      q[4] = BCD::encode(msf.second);
+      q[5] = BCD::encode(msf.frame);
+      q[6] = 0x00;
+      msf = MSF(lba);
+      q[7] = BCD::encode(msf.minute);
+      q[8] = BCD::encode(msf.second);
+      q[9] = BCD::encode(msf.frame);
+    } else if(auto location = locate(lba)) {
+      auto& track = tracks[location->track];
+      q[0] = track.control << 4 | 1;
+      q[1] = BCD::encode(location->track);
+      q[2] = BCD::encode(location->index);
+      auto msf = location->index == 0
+      ? MSF(track.indices[0].end - lba)
+      : MSF(lba - track.indices[1].lba);
+      q[3] = BCD::encode(msf.minute);
+      q[4] = BCD::encode(msf.second);
+      q[5] = BCD::encode(msf.frame);
+      q[6] = 0x00;
+      msf = MSF(lba);
+      q[7] = BCD::encode(msf.minute);
+      q[8] = BCD::encode(msf.second);
+      q[9] = BCD::encode(msf.frame);
+    } else {
+      return;
+    }
+
+    auto crc16 = CRC16({q.data(), 10});
+    q[10] = crc16 >> 8;
+    q[11] = crc16 >> 0;
+  }
+
+  struct Location {
+    u8 track;
+    u8 index;
+  };
+
+  //finds the last index that starts at or before lba
+  auto locate(s32 lba) const -> maybe<Location> {
+    for(u8 trackID : reverse(range(100))) {
+      auto& track = tracks[trackID];
+      if(!track) continue;
+      if(track.indices[1].lba > lba && !(track.indices[0] && track.indices[0].lba <= lba)) continue;
+      for(u8 indexID : reverse(range(100))) {
+        auto& index = track.indices[indexID];
+        if(index && index.lba <= lba) return Location{trackID, indexID};
+      }
+    }
+    return {};
+  }
+
   auto decode(array_view<u8> data, u32 size, u32 leadOutSectors = 0) -> bool {
     *this = {};  //reset session
     //three data[] types supported: subcode Q only, subcode P-W only, data+subcode complete image
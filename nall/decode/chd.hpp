@@ -3,6 +3,7 @@
 #include <nall/file.hpp>
 #include <nall/maybe.hpp>
 #include <nall/string.hpp>
+#include <nall/thread.hpp>
 #include <libchdr/chd.h>
 
 namespace nall::Decode {
@@ -30,16 +31,59 @@ struct CHD {
 
   auto load(const string& location) -> bool;
   auto read(u32 sector) const -> vector<u8>;
+  auto read(u32 sector, u32 count, array_span<u8> output, u32 stride = 2352, u32 threads = 1) const -> bool;
   auto sectorCount() const -> u32;
 
   vector<Track> tracks;
 private:
+  enum class Format : u8 { Raw, Audio, Mode1 };
+
+  //a run of consecutive disc sectors stored as consecutive CHD frames
+  struct Run {
+    u32 lba;
+    u32 count;
+    u32 frame;
+    Format format;
+  };
+
+  //one sector of a read: where it lives in the CHD and where it goes
+  struct Job {
+    u32 hunk;
+    u32 offset;
+    u8* target;
+    Format format;
+  };
+
+  struct Hunk {
+    s32 number = -1;
+    u64 used = 0;
+    vector<u8> data;
+  };
+
+  //additional handles on the same file; libchdr decoders are not reentrant
+  struct Decoder {
+    ~Decoder() { if(chd) chd_close(chd); }
+    file_buffer fp;
+    chd_file* chd = nullptr;
+  };
+
+  auto find(u32 sector) const -> const Run*;
+  auto schedule(u32 sector, u32 count, u8* output, u32 stride) const -> vector<Job>;
+  auto copy(const Job& job, const u8* hunk) const -> void;
+  auto decode(u32 number) const -> const u8*;
+  auto decode(const vector<Job>& jobs, u32 threads) const -> bool;
+
+  string location;
   file_buffer fp;
   chd_file* chd = nullptr;
   static constexpr int chd_sector_size = 2352 + 96;
+  static constexpr u32 CacheHunks = 16;
   size_t chd_hunk_size;
-  mutable vector<u8> chd_hunk_buffer;
-  mutable int chd_current_hunk = -1;
+  vector<Run> runs;
+  mutable Hunk cache[CacheHunks];
+  mutable u64 uses = 0;
+  mutable mutex lock;
+  mutable vector<shared_pointer<Decoder>> decoders;
 };
 
 inline CHD::~CHD() {
@@ -69,7 +113,7 @@ inline auto CHD::load(const string& location) -> bool {
     return false;
   }
 
-  chd_hunk_buffer.resize(chd_hunk_size);
+  this->location = location;
   u32 disc_lba = 0;
   u32 chd_lba = 0;
 
@@ -177,51 +221,162 @@ inline auto CHD::load(const string& location) -> bool {
     tracks.append(track);
   }
 
+  //index the stored sectors so that reads need not scan every track
+  for(auto& track : tracks) {
+    auto format = track.type == "AUDIO" ? Format::Audio : track.type == "MODE1" ? Format::Mode1 : Format::Raw;
+    for(auto& index : track.indices) {
+      if(index.chd_lba < 0 || !index.sectorCount()) continue;
+      runs.append({(u32)index.lba, index.sectorCount(), (u32)index.chd_lba, format});
+    }
+  }
+
   return true;
 }
 
 inline auto CHD::read(u32 sector) const -> vector<u8> {
-  // Convert LBA in CD-ROM to LBA in CHD
-  for(auto& track : tracks) {
-    for(auto& index : track.indices) {
-      if (sector >= index.lba && sector <= index.end) {
-        auto chd_lba = (sector - index.lba) + index.chd_lba;
+  auto run = find(sector);
+  if(!run) {
+    print("CHD: Attempting to read from unmapped sector ", sector, "\n");
+    return {};
+  }
 
-        vector<u8> output;
-        output.resize(track.type == "MODE1" ? 2048 : 2352);
+  vector<u8> output;
+  output.resize(2352);
+  read(sector, 1, {output.data(), output.size()});
+  if(run->format == Format::Mode1) output.resize(2048);
+  return output;
+}
 
-        int hunk = (chd_lba * chd_sector_size) / chd_hunk_size;
-        int offset = (chd_lba * chd_sector_size) % chd_hunk_size;
+//fills output with count sectors spaced stride bytes apart.
+//MODE1 sectors hold 2048 bytes of user data; all others hold 2352 bytes of raw data, audio in little-endian.
+//sectors not stored in the image (generated pregaps and postgaps) are zero-filled.
+inline auto CHD::read(u32 sector, u32 count, array_span<u8> output, u32 stride, u32 threads) const -> bool {
+  if(!count) return true;
+  if(output.size() < (u64)stride * (count - 1) + 2352) return false;
+  for(u32 n : range(count)) memory::fill<u8>(output.data() + (u64)stride * n, 2352);
+
+  auto jobs = schedule(sector, count, output.data(), stride);
+  if(threads > 1) return decode(jobs, threads);
+
+  lock_guard<mutex> guard(lock);
+  for(auto& job : jobs) {
+    auto hunk = decode(job.hunk);
+    if(!hunk) return false;
+    copy(job, hunk);
+  }
+  return true;
+}
 
-        if (hunk != chd_current_hunk) {
-          chd_read(chd, hunk, chd_hunk_buffer.data());
-          chd_current_hunk = hunk;
-        }
+inline auto CHD::find(u32 sector) const -> const Run* {
+  u32 lo = 0, hi = runs.size();
+  while(lo < hi) {
+    u32 mid = lo + hi >> 1;
+    if(runs[mid].lba <= sector) lo = mid + 1;
+    else hi = mid;
+  }
+  if(lo == 0) return nullptr;
+  auto& run = runs[lo - 1];
+  if(sector - run.lba >= run.count) return nullptr;
+  return &run;
+}
 
-        // Audio data is in big-endian, so we need to byteswap
-        if (track.type == "AUDIO") {
-          u8* src_ptr = chd_hunk_buffer.data() + offset;
-          u8* dst_ptr = output.data();
-          const int value_count = 2352 / sizeof(uint16_t);
-          for (int i = 0; i < value_count; i++) {
-            u16 value;
-            memcpy(&value, src_ptr, sizeof(value));
-            value = (value << 8) | (value >> 8);
-            memcpy(dst_ptr, &value, sizeof(value));
-            src_ptr += sizeof(value);
-            dst_ptr += sizeof(value);
-          }
-        } else {
-          std::copy(chd_hunk_buffer.data() + offset, chd_hunk_buffer.data() + offset + output.size(), output.data());
-        }
+//frames increase with the disc sector, so the jobs come out grouped by hunk
+inline auto CHD::schedule(u32 sector, u32 count, u8* output, u32 stride) const -> vector<Job> {
+  vector<Job> jobs;
+  for(u32 n : range(count)) {
+    auto run = find(sector + n);
+    if(!run) continue;
+    u64 position = (u64)(run->frame + sector + n - run->lba) * chd_sector_size;
+    jobs.append({u32(position / chd_hunk_size), u32(position % chd_hunk_size), output + (u64)stride * n, run->format});
+  }
+  return jobs;
+}
 
-        return output;
-      }
+inline auto CHD::copy(const Job& job, const u8* hunk) const -> void {
+  auto source = hunk + job.offset;
+  if(job.format == Format::Audio) {
+    //audio data is in big-endian, so we need to byteswap
+    for(u32 n = 0; n < 2352; n += 2) {
+      job.target[n + 0] = source[n + 1];
+      job.target[n + 1] = source[n + 0];
+    }
+  } else {
+    memory::copy(job.target, source, job.format == Format::Mode1 ? 2048 : 2352);
+  }
+}
+
+//returns the decompressed hunk through the cache, evicting the least recently used entry on a miss
+inline auto CHD::decode(u32 number) const -> const u8* {
+  Hunk* victim = &cache[0];
+  for(auto& hunk : cache) {
+    if(hunk.number == (s32)number) {
+      hunk.used = ++uses;
+      return hunk.data.data();
+    }
+    if(hunk.used < victim->used) victim = &hunk;
+  }
+
+  victim->data.resize(chd_hunk_size);
+  if(chd_read(chd, number, victim->data.data()) != CHDERR_NONE) {
+    victim->number = -1;
+    victim->used = 0;
+    return nullptr;
+  }
+  victim->number = number;
+  victim->used = ++uses;
+  return victim->data.data();
+}
+
+//decodes the hunks of a large read on several threads, each with its own handle on the file.
+//intended for whole-disc conversion and verification; the hunk cache is bypassed.
+inline auto CHD::decode(const vector<Job>& jobs, u32 threads) const -> bool {
+  vector<u32> groups;  //index of the first job of each hunk
+  for(u32 n : range(jobs.size())) {
+    if(!n || jobs[n].hunk != jobs[n - 1].hunk) groups.append(n);
+  }
+  threads = min(threads, (u32)groups.size());
+  if(threads <= 1) {
+    lock_guard<mutex> guard(lock);
+    for(auto& job : jobs) {
+      auto hunk = decode(job.hunk);
+      if(!hunk) return false;
+      copy(job, hunk);
     }
+    return true;
   }
 
-  print("CHD: Attempting to read from unmapped sector ", sector, "\n");
-  return {};
+  {
+    lock_guard<mutex> guard(lock);
+    while(decoders.size() < threads) {
+      auto decoder = shared_pointer<Decoder>::create();
+      decoder->fp = file::open(location, file::mode::read);
+      if(!decoder->fp) return false;
+      if(chd_open_file(decoder->fp.handle(), CHD_OPEN_READ, nullptr, &decoder->chd) != CHDERR_NONE) return false;
+      decoders.append(decoder);
+    }
+  }
+
+  atomic<u32> next = 0;
+  atomic<bool> failed = false;
+  vector<thread> workers;
+  for(u32 n : range(threads)) {
+    workers.append(thread::create([&](uintptr id) -> void {
+      auto& decoder = *decoders[id];
+      vector<u8> data;
+      data.resize(chd_hunk_size);
+      for(u32 group = next++; group < groups.size() && !failed; group = next++) {
+        u32 first = groups[group];
+        u32 last = group + 1 < groups.size() ? groups[group + 1] : jobs.size();
+        if(chd_read(decoder.chd, jobs[first].hunk, data.data()) != CHDERR_NONE) {
+          failed = true;
+          break;
+        }
+        for(u32 n = first; n < last; n++) copy(jobs[n], data.data());
+      }
+    }, n));
+  }
+  for(auto& worker : workers) worker.join();
+  return !failed;
 }
 
 inline auto CHD::sectorCount() const -> u32 {
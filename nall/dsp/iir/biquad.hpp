@@ -17,6 +17,7 @@ struct Biquad {
 
   auto reset(Type type, f64 cutoffFrequency, f64 samplingFrequency, f64 quality, f64 gain = 0.0) -> void;
   auto process(f64 in) -> f64;  //normalized sample (-1.0 to +1.0)
+  auto process(f64* samples, u32 count) -> void;
 
   static auto shelf(f64 gain, f64 slope) -> f64;
   static auto butterworth(u32 order, u32 phase) -> f64;
@@ -148,6 +149,21 @@ inline auto Biquad::process(f64 in) -> f64 {
   return out;
 }
 
+//filters a block of samples in place
+inline auto Biquad::process(f64* samples, u32 count) -> void {
+  f64 a0 = this->a0, a1 = this->a1, a2 = this->a2, b1 = this->b1, b2 = this->b2;
+  f64 z1 = this->z1, z2 = this->z2;
+  for(u32 n : range(count)) {
+    f64 in = samples[n];
+    f64 out = in * a0 + z1;
+    z1 = in * a1 + z2 - b1 * out;
+    z2 = in * a2 - b2 * out;
+    samples[n] = out;
+  }
+  this->z1 = z1;
+  this->z2 = z2;
+}
+
 //compute Q values for low-shelf and high-shelf filtering
 inline auto Biquad::shelf(f64 gain, f64 slope) -> f64 {
   f64 a = pow(10, gain / 40);
@@ -12,6 +12,7 @@ struct OnePole {
 
   auto reset(Type type, f64 cutoffFrequency, f64 samplingFrequency) -> void;
   auto process(f64 in) -> f64;  //normalized sample (-1.0 to +1.0)
+  auto process(f64* samples, u32 count) -> void;
 
 private:
   Type type;
@@ -41,4 +42,11 @@ inline auto OnePole::process(f64 in) -> f64 {
   return z1 = in * a0 + z1 * b1;
 }
 
+//filters a block of samples in place
+inline auto OnePole::process(f64* samples, u32 count) -> void {
+  f64 a0 = this->a0, b1 = this->b1, z1 = this->z1;
+  for(u32 n : range(count)) samples[n] = z1 = samples[n] * a0 + z1 * b1;
+  this->z1 = z1;
+}
+
 }
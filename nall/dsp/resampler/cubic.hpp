@@ -14,6 +14,7 @@ struct Cubic {
   auto pending() const -> bool;
   auto read() -> f64;
   auto write(f64 sample) -> void;
+  auto write(const f64* samples, u32 count) -> void;
   auto serialize(serializer&) -> void;
 
 private:
@@ -71,6 +72,33 @@ inline auto Cubic::write(f64 sample) -> void {
   mu -= 1.0;
 }
 
+inline auto Cubic::write(const f64* samples, u32 count) -> void {
+  f64 mu = _fraction;
+  f64 s0 = _history[0], s1 = _history[1], s2 = _history[2], s3 = _history[3];
+
+  for(u32 n : range(count)) {
+    s0 = s1;
+    s1 = s2;
+    s2 = s3;
+    s3 = samples[n];
+
+    f64 A = s3 - s2 - s0 + s1;
+    f64 B = s0 - s1 - A;
+    f64 C = s2 - s0;
+    f64 D = s1;
+
+    while(mu <= 1.0) {
+      _samples.write(A * mu * mu * mu + B * mu * mu + C * mu + D);
+      mu += _ratio;
+    }
+
+    mu -= 1.0;
+  }
+
+  _fraction = mu;
+  _history[0] = s0, _history[1] = s1, _history[2] = s2, _history[3] = s3;
+}
+
 inline auto Cubic::serialize(serializer& s) -> void {
   s(_inputFrequency);
   s(_outputFrequency);
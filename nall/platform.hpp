@@ -56,6 +56,8 @@ namespace Math {
 #if defined(ARCHITECTURE_X86) || defined(ARCHITECTURE_AMD64)
   #include <immintrin.h>
   #undef _serialize
+#elif defined(ARCHITECTURE_ARM64)
+  #include <arm_neon.h>
 #endif
 
 #if !defined(__has_builtin)
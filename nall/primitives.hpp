@@ -21,6 +21,10 @@ namespace nall {
 #include <nall/primitives/literals.hpp>
 
 namespace nall {
+  template<> struct is_serializer_pod<Boolean> : std::bool_constant<sizeof(Boolean) == sizeof(bool)> {};
+  template<uint Bits> struct is_serializer_pod<Natural<Bits>> : std::bool_constant<sizeof(Natural<Bits>) == sizeof(typename Natural<Bits>::utype)> {};
+  template<uint Bits> struct is_serializer_pod<Integer<Bits>> : std::bool_constant<sizeof(Integer<Bits>) == sizeof(typename Integer<Bits>::stype)> {};
+
   template<uint Bits> auto Natural<Bits>::integer() const -> Integer<Bits> { return Integer<Bits>(*this); }
   template<uint Bits> auto Integer<Bits>::natural() const -> Natural<Bits> { return Natural<Bits>(*this); }
 }
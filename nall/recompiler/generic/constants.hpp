@@ -54,6 +54,7 @@
 
   struct mem : public op_base {
     mem(sreg base, sljit_sw offset) : op_base(SLJIT_MEM1(base.fst), offset) {}
+    mem(reg base, sljit_sw offset) : op_base(SLJIT_MEM1(base.fst), offset) {}
   };
 
   struct unused {
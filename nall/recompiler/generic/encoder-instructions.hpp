@@ -137,4 +137,9 @@
   auto lea(reg r, sreg base, sljit_sw offset) {
     add64(r, base, imm(offset));
   }
+
+  template<typename T>
+  auto ijump(T target) {
+    sljit_emit_ijump(compiler, SLJIT_JUMP, target.fst, target.snd);
+  }
 //};
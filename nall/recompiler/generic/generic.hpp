@@ -8,12 +8,15 @@ namespace nall::recompiler {
     bump_allocator& allocator;
     sljit_compiler* compiler = nullptr;
     sljit_label* epilogue = nullptr;
+    sljit_label* entry = nullptr;
 
     generic(bump_allocator& alloc) : allocator(alloc) {}
     ~generic() { resetCompiler(); }
 
-    auto beginFunction(int args) -> void {
-      assert(args <= 3);
+    //fscratches: host vector registers (SLJIT_FR0 and up) the function may use
+    auto beginFunction(int args, int saveds = 3, int fscratches = 0) -> void {
+      assert(args <= 3 && args <= saveds && saveds <= SLJIT_NUMBER_OF_SAVED_REGISTERS);
+      assert(fscratches <= SLJIT_NUMBER_OF_FLOAT_REGISTERS);
       resetCompiler();
       compiler = sljit_create_compiler(nullptr, &allocator);
 
@@ -21,16 +24,25 @@ namespace nall::recompiler {
       if(args >= 1) options |= SLJIT_ARG_VALUE(SLJIT_ARG_TYPE_W, 1);
       if(args >= 2) options |= SLJIT_ARG_VALUE(SLJIT_ARG_TYPE_W, 2);
       if(args >= 3) options |= SLJIT_ARG_VALUE(SLJIT_ARG_TYPE_W, 3);
-      sljit_emit_enter(compiler, 0, options, 4, 3, 0, 0, 0);
-      sljit_jump* entry = sljit_emit_jump(compiler, SLJIT_JUMP);
+      sljit_emit_enter(compiler, 0, options, 4, saveds, fscratches, 0, 0);
+      sljit_jump* skip = sljit_emit_jump(compiler, SLJIT_JUMP);
       epilogue = sljit_emit_label(compiler);
       sljit_emit_return_void(compiler);
 
-      sljit_set_label(entry, sljit_emit_label(compiler));
+      entry = sljit_emit_label(compiler);
+      sljit_set_label(skip, entry);
     }
 
     auto endFunction() -> u8* {
+      u8* body;
+      return endFunction(body);
+    }
+
+    //body receives the address just past the prologue: functions begun with the same arguments
+    //share one stack frame layout, so they may jump directly into each other's bodies.
+    auto endFunction(u8*& body) -> u8* {
       u8* code = (u8*)sljit_generate_code(compiler);
+      body = (u8*)sljit_get_label_addr(entry);
       allocator.reserve(sljit_get_generated_code_size(compiler));
       resetCompiler();
       return code;
@@ -40,6 +52,7 @@ namespace nall::recompiler {
       if(compiler) sljit_free_compiler(compiler);
       compiler = nullptr;
       epilogue = nullptr;
+      entry = nullptr;
     }
 
     auto testJumpEpilog() -> void {
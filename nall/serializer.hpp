@@ -30,6 +30,11 @@ struct has_serialize {
 };
 template<typename T> constexpr bool has_serialize_v = has_serialize<T>::value;
 
+//types whose in-memory representation is identical to their serialized representation (on little-endian hosts.)
+//arrays of these types are serialized with a single bulk copy instead of element by element.
+template<typename T> struct is_serializer_pod : std::bool_constant<is_integral_v<T>> {};
+template<typename T> constexpr bool is_serializer_pod_v = is_serializer_pod<T>::value;
+
 struct serializer {
   explicit operator bool() const {
     return _size;
@@ -66,13 +71,7 @@ struct serializer {
   }
 
   auto reserve(u32 size) -> void {
-    if(size > _capacity) {
-      auto data = new u8[bit::round(size)]();
-      memory::copy(data, _data, _capacity);
-      delete[] _data;
-      _data = data;
-      _capacity = bit::round(size);
-    }
+    if(size > _capacity) grow(size);
   }
 
   template<typename T> auto operator()(T& value) -> serializer& {
@@ -88,11 +87,13 @@ struct serializer {
   }
 
   template<typename T, s32 N> auto operator()(T (&array)[N]) -> serializer& {
+    if constexpr(is_serializer_pod_v<T>) return bulk(array, N);
     for(auto& value : array) operator()(value);
     return *this;
   }
 
   template<typename T> auto operator()(array_span<T> array) -> serializer& {
+    if constexpr(is_serializer_pod_v<T>) return bulk(array.data(), array.size());
     for(auto& value : array) operator()(value);
     return *this;
   }
@@ -120,6 +121,8 @@ struct serializer {
     _capacity = s._capacity;
 
     s._data = nullptr;
+    s._size = 0;
+    s._capacity = 0;
     return *this;
   }
 
@@ -135,7 +138,7 @@ struct serializer {
 
   serializer(const u8* data, u32 capacity) {
     setReading();
-    _data = new u8[capacity]();
+    _data = new u8[capacity];
     _size = 0;
     _capacity = capacity;
     memory::copy(_data, data, capacity);
@@ -146,9 +149,59 @@ struct serializer {
   }
 
 private:
+  //capacity grows geometrically, so that many small writes past the end only reallocate a handful of times.
+  //newly allocated space is zero-filled, so that reading past the end of a truncated state is well-defined.
+  auto grow(u32 size) -> void {
+    u32 capacity = max(bit::round(size), (u64)_capacity << 1);
+    auto data = new u8[capacity];
+    memory::copy(data, _data, _capacity);
+    memory::fill(data + _capacity, capacity - _capacity);
+    delete[] _data;
+    _data = data;
+    _capacity = capacity;
+  }
+
+  template<typename T> auto bulk(const T* array, u32 count) -> serializer& {
+    static_assert(sizeof(bool) == 1);
+    const u32 size = count * sizeof(T);
+    reserve(_size + size);
+    auto data = (T*)array;
+    #if defined(ENDIAN_LITTLE)
+    if(writing()) memory::copy(_data + _size, data, size);
+    if(reading()) memory::copy(data, _data + _size, size);
+    #else
+    //byte-swap each element; written as a plain loop over whole elements so that it vectorizes
+    if(writing()) {
+      memory::copy(_data + _size, data, size);
+      if constexpr(sizeof(T) > 1) byteswap((T*)(_data + _size), count);
+    }
+    if(reading()) {
+      memory::copy(data, _data + _size, size);
+      if constexpr(sizeof(T) > 1) byteswap(data, count);
+    }
+    #endif
+    _size += size;
+    return *this;
+  }
+
+  template<typename T> static auto byteswap(T* data, u32 count) -> void {
+    for(u32 n : range(count)) {
+      auto p = (u8*)&data[n];
+      for(u32 byte : range(sizeof(T) / 2)) std::swap(p[byte], p[sizeof(T) - 1 - byte]);
+    }
+  }
+
   template<typename T> auto integer(T& value) -> serializer& {
     enum : u32 { size = std::is_same<bool, T>::value ? 1 : sizeof(T) };
     reserve(_size + size);
+    #if defined(ENDIAN_LITTLE)
+    if constexpr(size == sizeof(T)) {
+      if(writing()) memory::copy(_data + _size, &value, size);
+      if(reading()) memory::copy(&value, _data + _size, size);
+      _size += size;
+      return *this;
+    }
+    #endif
     if(writing()) {
       for(u32 n : range(size)) _data[_size++] = value >> (n << 3);
     } else if(reading()) {
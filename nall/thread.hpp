@@ -9,11 +9,14 @@
 #include <nall/platform.hpp>
 #include <nall/function.hpp>
 #include <nall/intrinsics.hpp>
+#include <condition_variable>
 
 namespace nall {
   using mutex = std::mutex;
   using recursive_mutex = std::recursive_mutex;
+  using condition_variable = std::condition_variable;
   template<typename T> using lock_guard = std::lock_guard<T>;
+  template<typename T> using unique_lock = std::unique_lock<T>;
   template<typename T> using atomic = std::atomic<T>;
 }
 
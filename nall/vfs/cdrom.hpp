@@ -3,15 +3,26 @@
 #include <nall/array-span.hpp>
 #include <nall/cd.hpp>
 #include <nall/file.hpp>
+#include <nall/file-map.hpp>
 #include <nall/string.hpp>
+#include <nall/thread.hpp>
+#include <thread>
 #include <nall/decode/cue.hpp>
 #include <nall/decode/chd.hpp>
 #include <nall/decode/wav.hpp>
 
 namespace nall::vfs {
 
+//sectors are read from the disc image on demand: BIN and WAV tracks through a memory map of their files,
+//CHD images through a small cache of decoded pages that a worker thread reads ahead of sequential accesses.
+//subchannel data is generated for each sector as it is read.
 struct cdrom : file {
   ~cdrom() {
+    if(!_chd) return;
+    _lock.lock();
+    _quit = true;
+    _lock.unlock();
+    _wake.notify_all();
     _thread.join();
   }
 
@@ -23,9 +34,10 @@ struct cdrom : file {
   }
 
   auto writable() const -> bool override { return false; }
-  auto data() const -> const u8* override { wait(size()); return _image.data(); }
-  auto data() -> u8* override { wait(size()); return _image.data(); }
-  auto size() const -> u64 override { return _image.size(); }
+  //the image is not held in memory: requesting it as a whole assembles every sector of the disc
+  auto data() const -> const u8* override { return const_cast<cdrom*>(this)->image().data(); }
+  auto data() -> u8* override { return image().data(); }
+  auto size() const -> u64 override { return 2448ull * _sectors; }
   auto offset() const -> u64 override { return _offset; }
 
   auto resize(u64 size) -> bool override {
@@ -39,31 +51,47 @@ struct cdrom : file {
   }
 
   auto read() -> u8 override {
-    if(_offset >= _image.size()) return 0x00;
-    wait(_offset);
-    return _image[_offset++];
+    if(_offset >= size()) return 0x00;
+    u32 sector = _offset / 2448;
+    u32 byte = _offset++ % 2448;
+    if(_image) return _image[2448ull * sector + byte];
+    if(byte >= 2352) {
+      //the cores scan the subchannel of the entire disc on load: avoid reading user data for it
+      if(sector != _subchannelSector) loadSubchannel(sector, _buffer + 2352);
+      _subchannelSector = sector;
+      return _buffer[byte];
+    }
+    if(sector != _sector) {
+      load(sector, _buffer);
+      _sector = sector;
+      _subchannelSector = sector;
+    }
+    return _buffer[byte];
   }
 
   auto write(u8 data) -> void override {
-    //CD-ROMs are read-only; but allow writing anyway if needed, since the image is in memory
-    if(_offset >= _image.size()) return;
-    wait(_offset);
-    _image[_offset++] = data;
-  }
-
-  auto wait(u64 offset) const -> void {
-    bool force = false;
-    if(offset >= _image.size()) {
-      offset = _image.size() - 1;
-      force = true;
-    }
-    //subchannel data is always loaded
-    if(offset % 2448 < 2352 || force) {
-      while(offset + 1 > _loadOffset) usleep(1);
-    }
+    //CD-ROMs are read-only
+    if(_offset >= size()) return;
+    _offset++;
   }
 
 private:
+  //a run of consecutive sectors that are stored in the image
+  struct Extent {
+    u32 sector;  //first sector, counted from the start of the lead-in
+    u32 count;
+    u32 length;  //bytes stored per sector: 2048 (user data only) or 2352
+    u32 file;    //index into _files; unused for CHD images
+    u64 offset;  //byte offset of the first sector within its file
+  };
+
+  //decoded CHD sectors, with room for 2352 bytes per sector
+  struct Page {
+    s32 index = -1;
+    u64 used = 0;
+    vector<u8> data;
+  };
+
   auto loadCue(const string& cueLocation) -> bool {
     auto cuesheet = shared_pointer<Decode::CUE>::create();
     if(!cuesheet->load(cueLocation)) return false;
@@ -115,72 +143,32 @@ private:
     session.leadOut.lba = lbaFileBase;
     session.leadOut.end = lbaFileBase + LeadOutSectors - 1;
 
-    // determine track and index ranges
-    session.firstTrack = 0xff;
-    for(u32 track : range(100)) {
-      if(!session.tracks[track]) continue;
-      if(session.firstTrack > 99) session.firstTrack = track;
-      // find first index
-      for(u32 indexID : range(100)) {
-        auto& index = session.tracks[track].indices[indexID];
-        if(index) { session.tracks[track].firstIndex = indexID; break; }
-      }
-      // find last index
-      for(u32 indexID : reverse(range(100))) {
-        auto& index = session.tracks[track].indices[indexID];
-        if(index) { session.tracks[track].lastIndex = indexID; break; }
-      }
-      session.lastTrack = track;
-    }
-
-    _image.resize(2448 * (LeadInSectors + lbaFileBase + LeadOutSectors));
-
-    //preload subchannel data
-    loadSub({Location::notsuffix(cueLocation), ".sub"}, session);
-
-    //load user data on separate thread
-    _thread = thread::create(
-    [this, cueLocation, cuesheet = std::move(cuesheet)](uintptr) -> void {
+    loadSession(session);
+    loadSub({Location::notsuffix(cueLocation), ".sub"});
 
-    s32 lbaFileBase = 0;
+    //map the user data of each file
+    lbaFileBase = 0;
     for(auto& file : cuesheet->files) {
       auto location = string{Location::path(cueLocation), file.name};
-      auto filedata = nall::file::open(location, nall::file::mode::read);
-      if(file.type == "wave") filedata.seek(44);  //skip RIFF header
+      _files.append(shared_pointer<file_map>::create(location, file_map::mode::read));
+      u64 offset = file.type == "wave" ? 44 : 0;  //skip RIFF header
       for(auto& track : file.tracks) {
         if(track.pregap) lbaFileBase += track.pregap();
         for(auto& index : track.indices) {
           if(index.lba < 0) continue; // ignore gaps (not in file)
-          for(s32 sector : range(index.sectorCount())) {
-            auto offset = 2448ull * (LeadInSectors + lbaFileBase + index.lba + sector);
-            auto target = _image.data() + offset;
-            auto length = track.sectorSize();
-            if(length == 2048) {
-              //ISO: generate header + parity data
-              memory::assign(target + 0, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff);  //sync
-              memory::assign(target + 6, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00);  //sync
-              auto [minute, second, frame] = CD::MSF(lbaFileBase + index.lba + sector);
-              target[12] = BCD::encode(minute);
-              target[13] = BCD::encode(second);
-              target[14] = BCD::encode(frame);
-              target[15] = 0x01;  //mode
-              filedata.read({target + 16, length});
-              CD::RSPC::encodeMode1({target, 2352});
-            }
-            if(length == 2352) {
-              //BIN + WAV: direct copy
-              filedata.read({target, length});
-            }
-            _loadOffset = offset + 2448;
-          }
+          Extent extent;
+          extent.sector = LeadInSectors + lbaFileBase + index.lba;
+          extent.count = index.sectorCount();
+          extent.length = track.sectorSize();
+          extent.file = _files.size() - 1;
+          extent.offset = offset;
+          offset += (u64)extent.length * extent.count;
+          if(extent.count && extent.length) _extents.append(extent);
         }
         if(track.postgap) lbaFileBase += track.postgap();
       }
       lbaFileBase += file.tracks.last().indices.last().end + 1;
     }
-    _loadOffset = _image.size();
-
-    });
 
     return true;
   }
@@ -206,6 +194,29 @@ private:
     session.leadOut.lba = lbaIndex;
     session.leadOut.end = lbaIndex + LeadOutSectors - 1;
 
+    loadSession(session);
+    loadSub({Location::notsuffix(location), ".sub"});
+
+    for(auto& track : chd->tracks) {
+      for(auto& index : track.indices) {
+        if(index.chd_lba < 0) continue;  //gaps not stored in the image
+        Extent extent;
+        extent.sector = LeadInSectors + index.lba;
+        extent.count = index.sectorCount();
+        extent.length = track.type == "MODE1" ? 2048 : 2352;
+        extent.file = 0;
+        extent.offset = 0;
+        if(extent.count) _extents.append(extent);
+      }
+    }
+
+    _chd = chd;
+    _pages.resize(Pages);
+    _thread = thread::create({&cdrom::main, this});
+    return true;
+  }
+
+  auto loadSession(CD::Session& session) -> void {
     // determine track and index ranges
     session.firstTrack = 0xff;
     for(u32 track : range(100)) {
@@ -224,73 +235,198 @@ private:
       session.lastTrack = track;
     }
 
-    _image.resize(2448 * (LeadInSectors + lbaIndex + LeadOutSectors));
+    _session = session;
+    _sectors = LeadInSectors + session.leadOut.end + 1;
+  }
 
-    //preload subchannel data
-    loadSub({Location::notsuffix(location), ".sub"}, session);
+  auto loadSub(const string& location) -> void {
+    if(nall::file::exists(location)) _subchannel.open(location, file_map::mode::read);
+  }
 
-    //load user data on separate thread
-    _thread = thread::create(
-    [this, chd = std::move(chd)](uintptr) -> void {
+  //the extent containing the sector, if any
+  auto find(u32 sector) const -> const Extent* {
+    u32 lo = 0, hi = _extents.size();
+    while(lo < hi) {
+      u32 mid = lo + hi >> 1;
+      if(_extents[mid].sector <= sector) lo = mid + 1;
+      else hi = mid;
+    }
+    if(lo == 0) return nullptr;
+    auto& extent = _extents[lo - 1];
+    if(sector - extent.sector >= extent.count) return nullptr;
+    return &extent;
+  }
 
-    s32 lba = 0;
-    for(auto& track : chd->tracks) {
-      for(auto& index : track.indices) {
-        for(s32 sector : range(index.sectorCount())) {
-          auto offset = 2448ull * (LeadInSectors + index.lba + sector);
-          auto target = _image.data() + offset;
-          auto sectorData = chd->read(lba);
-          if(sectorData.size() == 2048) {
-            //ISO: generate header + parity data
-            memory::assign(target + 0, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff);  //sync
-            memory::assign(target + 6, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00);  //sync
-            auto [minute, second, frame] = CD::MSF(index.lba + sector);
-            target[12] = BCD::encode(minute);
-            target[13] = BCD::encode(second);
-            target[14] = BCD::encode(frame);
-            target[15] = 0x01;  //mode
-            memory::copy(target + 16, 2048, sectorData.data(), sectorData.size());
-            CD::RSPC::encodeMode1({target, 2352});
-          } else {
-            memory::copy(target, 2352, sectorData.data(), sectorData.size());
-          }
-          lba++;
-          _loadOffset = offset + 2448;
+  auto load(u32 sector, u8* target, const u8* decoded = nullptr) -> void {
+    s32 lba = (s32)sector - LeadInSectors;
+    memory::fill<u8>(target, 2352);
+
+    if(auto extent = find(sector)) {
+      u8* output = extent->length == 2048 ? target + 16 : target;
+      if(_chd) {
+        if(decoded) memory::copy(output, decoded, extent->length);
+        else fetch(lba, output, extent->length);
+      } else {
+        auto& map = *_files[extent->file];
+        u64 offset = extent->offset + (u64)extent->length * (sector - extent->sector);
+        if(offset < map.size()) {
+          memory::copy(output, map.data() + offset, min<u64>(extent->length, map.size() - offset));
         }
       }
+      if(extent->length == 2048) {
+        //ISO: generate header + parity data
+        memory::assign(target + 0, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff);  //sync
+        memory::assign(target + 6, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00);  //sync
+        auto [minute, second, frame] = CD::MSF(lba);
+        target[12] = BCD::encode(minute);
+        target[13] = BCD::encode(second);
+        target[14] = BCD::encode(frame);
+        target[15] = 0x01;  //mode
+        CD::RSPC::encodeMode1({target, 2352});
+      }
     }
-    _loadOffset = _image.size();
 
-    });
+    loadSubchannel(sector, target + 2352);
+  }
 
-    return true;
+  auto loadSubchannel(u32 sector, u8* target) -> void {
+    _session.encode((s32)sector - LeadInSectors, {target, 96});
+    if(sector >= LeadInSectors + Track1Pregap) {
+      //a subchannel file overrides the generated data from the start of the first track
+      u64 offset = 96ull * (sector - LeadInSectors - Track1Pregap);
+      if(offset < _subchannel.size()) {
+        memory::copy(target, _subchannel.data() + offset, min<u64>(96, _subchannel.size() - offset));
+      }
+    }
   }
 
-private:
-  void loadSub(const string& location, const CD::Session& session) {
-    auto subchannel = session.encode(LeadInSectors + session.leadOut.end + 1);
+  auto image() -> vector<u8>& {
+    if(!_image) {
+      vector<u8> image;
+      image.resize(size());
+      //CHD images are converted in large chunks, decoding their hunks on every core
+      vector<u8> chunk;
+      if(_chd) chunk.resize(Chunk * 2352);
+      u32 threads = max(1u, std::thread::hardware_concurrency());
+      for(u32 sector : range(_sectors)) {
+        s32 lba = (s32)sector - LeadInSectors;
+        const u8* decoded = nullptr;
+        if(_chd && lba >= 0) {
+          if(lba % Chunk == 0) _chd->read(lba, Chunk, {chunk.data(), chunk.size()}, 2352, threads);
+          decoded = chunk.data() + 2352 * (lba % Chunk);
+        }
+        load(sector, image.data() + 2448ull * sector, decoded);
+      }
+      _image = std::move(image);
+    }
+    return _image;
+  }
 
-    if(auto overlay = nall::file::read(location)) {
-      auto target = subchannel.data() + 96 * (LeadInSectors + Track1Pregap);
-      auto length = (s64)subchannel.size() - 96 * (LeadInSectors + Track1Pregap);
-      memory::copy(target, length, overlay.data(), overlay.size());
+  //copies a CHD sector out of the page cache, waiting for the worker to decode its page if necessary
+  auto fetch(s32 lba, u8* target, u32 length) -> void {
+    s32 index = lba / PageSectors;
+    unique_lock<mutex> guard(_lock);
+    while(true) {
+      if(auto page = cached(index)) {
+        memory::copy(target, page->data.data() + (lba % PageSectors) * 2352, length);
+        page->used = ++_uses;
+        break;
+      }
+      if(_decoding != index) {
+        _request = index;
+        _wake.notify_one();
+      }
+      _ready.wait(guard);
     }
 
-    for(u64 sector : range(size() / 2448)) {
-      auto source = subchannel.data() + sector * 96;
-      auto target = _image.data() + sector * 2448 + 2352;
-      memory::copy(target, source, 96);
+    //read ahead of sequential accesses
+    for(s32 ahead : range(1, ReadAhead + 1)) {
+      s32 next = index + ahead;
+      if(next * PageSectors >= _session.leadOut.lba) break;
+      if(cached(next) || _decoding == next) continue;
+      _prefetch = next;
+      _wake.notify_one();
+      break;
     }
   }
 
-  vector<u8> _image;
+  auto cached(s32 index) -> Page* {
+    for(auto& page : _pages) {
+      if(page.index == index) return &page;
+    }
+    return nullptr;
+  }
+
+  //worker thread: decodes requested pages first, and pages read ahead otherwise
+  auto main(uintptr) -> void {
+    while(true) {
+      s32 index;
+      {
+        unique_lock<mutex> guard(_lock);
+        _wake.wait(guard, [&] { return _quit || _request >= 0 || _prefetch >= 0; });
+        if(_quit) return;
+        if(_request >= 0) {
+          index = _request;
+          _request = -1;
+        } else {
+          index = _prefetch;
+          _prefetch = -1;
+        }
+        if(cached(index)) continue;
+        _decoding = index;
+      }
+
+      vector<u8> data;
+      data.resize(PageSectors * 2352);
+      _chd->read(index * PageSectors, PageSectors, {data.data(), data.size()});
+
+      {
+        lock_guard<mutex> guard(_lock);
+        Page* victim = &_pages[0];
+        for(auto& page : _pages) {
+          if(page.used < victim->used) victim = &page;
+        }
+        victim->index = index;
+        victim->used = ++_uses;
+        victim->data = std::move(data);
+        _decoding = -1;
+      }
+      _ready.notify_all();
+    }
+  }
+
+  CD::Session _session;
+  u32 _sectors = 0;
   u64 _offset = 0;
-  atomic<u64> _loadOffset = 0;
+  vector<Extent> _extents;
+  vector<shared_pointer<file_map>> _files;
+  file_map _subchannel;
+  vector<u8> _image;
+
+  //the most recently read sector: user data of _sector, subchannel of _subchannelSector
+  u8  _buffer[2448];
+  u32 _sector = ~0;
+  u32 _subchannelSector = ~0;
+
+  shared_pointer<Decode::CHD> _chd;
+  vector<Page> _pages;
+  u64 _uses = 0;
+  s32 _request = -1;
+  s32 _prefetch = -1;
+  s32 _decoding = -1;
+  bool _quit = false;
+  mutex _lock;
+  condition_variable _wake;
+  condition_variable _ready;
   thread _thread;
 
   static constexpr s32 LeadInSectors  = 7500;
   static constexpr s32 Track1Pregap   =  150;
   static constexpr s32 LeadOutSectors = 6750;
+  static constexpr s32 PageSectors    =   16;
+  static constexpr u32 Pages          =   64;  //2.4 MB of decoded sectors
+  static constexpr s32 ReadAhead      =    4;  //pages decoded ahead of the most recently read one
+  static constexpr s32 Chunk          = 4096;  //sectors decoded at once when converting a CHD image to BIN
 };
 
 }
@@ -1,5 +1,7 @@
 #include <alsa/asoundlib.h>
 
+//mixed frames are handed to a dedicated output thread through a lock-free ring buffer.
+//the emulator never waits on the device: when blocking, it only waits for room in the ring.
 struct AudioALSA : AudioDriver {
   AudioALSA& self = *this;
   AudioALSA(Audio& super) : AudioDriver(super) {}
@@ -55,59 +57,24 @@ struct AudioALSA : AudioDriver {
   auto setFrequency(u32 frequency) -> bool override { return initialize(); }
   auto setLatency(u32 latency) -> bool override { return initialize(); }
 
+  //the fill level of the ring: dynamic rate control aims to keep it half full
   auto level() -> f64 override {
-    snd_pcm_sframes_t available;
-    for(u32 timeout : range(256)) {
-      available = snd_pcm_avail_update(_interface);
-      if(available >= 0) break;
-      snd_pcm_recover(_interface, available, 1);
-    }
-    return (f64)(_bufferSize - available) / _bufferSize;
+    return min(1.0, (f64)_ring.size() / _target);
   }
 
-  auto output(const f64 samples[]) -> void override {
-    _buffer[_offset]  = (u16)sclamp<16>(samples[0] * 32767.0) <<  0;
-    _buffer[_offset] |= (u16)sclamp<16>(samples[1] * 32767.0) << 16;
-    if(++_offset < _periodSize) return;
-
-    snd_pcm_sframes_t available;
-    do {
-      available = snd_pcm_avail_update(_interface);
-      if(available < 0) {
-        snd_pcm_recover(_interface, available, 1);
-        continue;
-      }
-      if(available < _offset) {
-        if(!self.blocking) {
-          _offset = 0;
-          return;
-        }
-        s32 error = snd_pcm_wait(_interface, -1);
-        if(error < 0) snd_pcm_recover(_interface, error, 1);
-      }
-    } while(available < _offset);
-
-    u32* output = _buffer;
-    s32 i = 4;
-
-    while(_offset > 0 && i--) {
-      snd_pcm_sframes_t written = snd_pcm_writei(_interface, output, _offset);
-      if(written < 0) {
-        //no samples written
-        snd_pcm_recover(_interface, written, 1);
-      } else if(written <= _offset) {
-        _offset -= written;
-        output += written;
-      }
-    }
+  auto underruns() -> u64 override {
+    return _underruns;
+  }
 
-    if(i < 0) {
-      if(_buffer == output) {
-        _offset--;
-        output++;
-      }
-      memory::move<u32>(_buffer, output, _offset);
+  auto output(const f64 samples[]) -> void override {
+    if(!_ready) return;
+    u32 frame = (u16)sclamp<16>(samples[0] * 32767.0) << 0 | (u16)sclamp<16>(samples[1] * 32767.0) << 16;
+    if(_ring.size() >= _target) {
+      if(!self.blocking) return;  //drop the frame rather than add latency
+      //the output thread drains the ring a period at a time
+      while(_ring.size() >= _target) usleep(500);
     }
+    _ring.write(frame);
   }
 
 private:
@@ -117,8 +84,9 @@ private:
     if(!hasDevices().find(self.device)) self.device = "default";
     if(snd_pcm_open(&_interface, self.device, SND_PCM_STREAM_PLAYBACK, SND_PCM_NONBLOCK) < 0) return terminate(), false;
 
+    //the latency is split evenly between the device buffer and the ring
     u32 rate = self.frequency;
-    u32 bufferTime = self.latency * 1000;
+    u32 bufferTime = self.latency * 1000 / 2;
     u32 periodTime = self.latency * 1000 / 8;
 
     snd_pcm_hw_params_t* hardwareParameters;
@@ -143,13 +111,22 @@ private:
     if(snd_pcm_sw_params(_interface, softwareParameters) < 0) return terminate(), false;
 
     _buffer = new uint32_t[_periodSize]();
-    _offset = 0;
+    _target = max(1u, min(Capacity, rate * self.latency / 2000));
+    _ring.flush();
+    _underruns = 0;
+    _running = true;
+    _thread = nall::thread::create({&AudioALSA::main, this});
     return _ready = true;
   }
 
   auto terminate() -> void {
     _ready = false;
 
+    if(_running) {
+      _running = false;
+      _thread.join();
+    }
+
     if(_interface) {
     //snd_pcm_drain(_interface);  //prevents popping noise; but causes multi-second lag
       snd_pcm_close(_interface);
@@ -162,6 +139,47 @@ private:
     }
   }
 
+  //output thread: moves frames from the ring to the device as room becomes available
+  auto main(uintptr) -> void {
+    while(_running) {
+      snd_pcm_sframes_t available = snd_pcm_avail_update(_interface);
+      if(available < 0) {
+        if(available == -EPIPE) _underruns++;
+        snd_pcm_recover(_interface, available, 1);
+        continue;
+      }
+
+      u32 frames = 0;
+      while(frames < min<u32>(available, _periodSize)) {
+        auto frame = _ring.read();
+        if(!frame) break;
+        _buffer[frames++] = frame();
+      }
+      if(!frames) {
+        //wait for the device to play a period, or for the emulator to produce one
+        if(available >= _periodSize) usleep(1000);
+        else if(s32 error = snd_pcm_wait(_interface, 100); error < 0) snd_pcm_recover(_interface, error, 1);
+        continue;
+      }
+
+      u32* output = _buffer;
+      while(frames && _running) {
+        snd_pcm_sframes_t written = snd_pcm_writei(_interface, output, frames);
+        if(written < 0) {
+          if(written == -EAGAIN) {
+            snd_pcm_wait(_interface, 100);
+            continue;
+          }
+          if(written == -EPIPE) _underruns++;
+          snd_pcm_recover(_interface, written, 1);
+          continue;
+        }
+        frames -= written;
+        output += written;
+      }
+    }
+  }
+
   bool _ready = false;
 
   snd_pcm_t* _interface = nullptr;
@@ -169,5 +187,11 @@ private:
   snd_pcm_uframes_t _periodSize;
 
   u32* _buffer = nullptr;
-  u32 _offset = 0;
+
+  static constexpr u32 Capacity = 16384;
+  nall::queue_spsc<u32[Capacity]> _ring;
+  u32 _target = 1;  //frames held in the ring before output blocks or drops
+  atomic<u64> _underruns = 0;
+  atomic<bool> _running = false;
+  nall::thread _thread;
 };
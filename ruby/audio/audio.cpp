@@ -123,6 +123,10 @@ auto Audio::level() -> f64 {
   return instance->level();
 }
 
+auto Audio::underruns() -> u64 {
+  return instance->underruns();
+}
+
 auto Audio::output(const f64 samples[]) -> void {
   if(!instance->dynamic) return instance->output(samples);
 
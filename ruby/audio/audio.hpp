@@ -35,6 +35,7 @@ struct AudioDriver {
 
   virtual auto clear() -> void {}
   virtual auto level() -> f64 { return 0.5; }
+  virtual auto underruns() -> u64 { return 0; }
   virtual auto output(const f64 samples[]) -> void {}
 
 protected:
@@ -98,6 +99,7 @@ struct Audio {
 
   auto clear() -> void;
   auto level() -> double;
+  auto underruns() -> u64;
   auto output(const f64 samples[]) -> void;
 
 protected:
@@ -0,0 +1,406 @@
+#include <nall/nall.hpp>
+using namespace nall;
+
+#include <nall/main.hpp>
+
+#include <ares/ares.hpp>
+#include <mia/mia.hpp>
+
+#ifdef CORE_A26
+  namespace ares::Atari2600 { auto load(Node::System& node, string name) -> bool; }
+#endif
+#ifdef CORE_CV
+  namespace ares::ColecoVision { auto load(Node::System& node, string name) -> bool; }
+#endif
+#ifdef CORE_MYVISION
+  namespace ares::MyVision { auto load(Node::System& node, string name) -> bool; }
+#endif
+#ifdef CORE_FC
+  namespace ares::Famicom { auto load(Node::System& node, string name) -> bool; }
+#endif
+#ifdef CORE_SFC
+  namespace ares::SuperFamicom {
+    auto load(Node::System& node, string name) -> bool;
+    auto option(string name, string value) -> bool;
+  }
+#endif
+#ifdef CORE_N64
+  namespace ares::Nintendo64 {
+    auto load(Node::System& node, string name) -> bool;
+    auto option(string name, string value) -> bool;
+  }
+#endif
+#ifdef CORE_GB
+  namespace ares::GameBoy { auto load(Node::System& node, string name) -> bool; }
+#endif
+#ifdef CORE_GBA
+  namespace ares::GameBoyAdvance { auto load(Node::System& node, string name) -> bool; }
+#endif
+#ifdef CORE_SG
+  namespace ares::SG1000 { auto load(Node::System& node, string name) -> bool; }
+#endif
+#ifdef CORE_MS
+  namespace ares::MasterSystem { auto load(Node::System& node, string name) -> bool; }
+#endif
+#ifdef CORE_MD
+  namespace ares::MegaDrive { auto load(Node::System& node, string name) -> bool; }
+#endif
+#ifdef CORE_PCE
+  namespace ares::PCEngine { auto load(Node::System& node, string name) -> bool; }
+#endif
+#ifdef CORE_PS1
+  namespace ares::PlayStation { auto load(Node::System& node, string name) -> bool; }
+#endif
+#ifdef CORE_NG
+  namespace ares::NeoGeo { auto load(Node::System& node, string name) -> bool; }
+#endif
+#ifdef CORE_NGP
+  namespace ares::NeoGeoPocket { auto load(Node::System& node, string name) -> bool; }
+#endif
+#ifdef CORE_MSX
+  namespace ares::MSX { auto load(Node::System& node, string name) -> bool; }
+#endif
+#ifdef CORE_SPEC
+  namespace ares::ZXSpectrum { auto load(Node::System& node, string name) -> bool; }
+#endif
+#ifdef CORE_WS
+  namespace ares::WonderSwan { auto load(Node::System& node, string name) -> bool; }
+#endif
+
+//runs a game with null video, audio and input for a fixed number of frames,
+//and reports how quickly the emulator core executed them.
+struct Benchmark : ares::Platform {
+  struct System {
+    string name;        //mia system name
+    string medium;      //mia medium name
+    string identifier;  //ares system name (without the region)
+    bool regional;      //whether the ares system name includes a region
+    string controller;  //device connected to each controller port
+    function<bool (ares::Node::System&, string)> load;
+  };
+
+  struct Event {
+    u64 frame;
+    string input;  //"port/input"
+    s64 value;
+  };
+
+  auto main(Arguments arguments) -> void;
+  auto construct() -> void;
+  auto load(const System&, const string& location) -> bool;
+  auto script(const string& location) -> bool;
+  auto region() -> string;
+
+  //platform.cpp
+  auto attach(ares::Node::Object) -> void override;
+  auto pak(ares::Node::Object) -> shared_pointer<vfs::directory> override;
+  auto video(ares::Node::Video::Screen, const u32* data, u32 pitch, u32 width, u32 height) -> void override;
+  auto audio(ares::Node::Audio::Stream) -> void override;
+  auto input(ares::Node::Input::Input) -> void override;
+
+  vector<System> systems;
+  ares::Node::System root;
+  shared_pointer<mia::Pak> system;
+  shared_pointer<mia::Pak> game;
+  string firmware;
+  string preferredRegion;
+
+  vector<Event> events;
+  map<string, s64> inputs;
+  u64 vblanks = 0;
+};
+
+auto Benchmark::construct() -> void {
+  #ifdef CORE_A26
+  systems.append({"Atari 2600", "Atari 2600", "[Atari] Atari 2600", true, "Gamepad", ares::Atari2600::load});
+  #endif
+  #ifdef CORE_CV
+  systems.append({"ColecoVision", "ColecoVision", "[Coleco] ColecoVision", true, "Gamepad", ares::ColecoVision::load});
+  #endif
+  #ifdef CORE_MYVISION
+  systems.append({"MyVision", "MyVision", "[Nichibutsu] MyVision", false, "", ares::MyVision::load});
+  #endif
+  #ifdef CORE_FC
+  systems.append({"Famicom", "Famicom", "[Nintendo] Famicom", true, "Gamepad", ares::Famicom::load});
+  #endif
+  #ifdef CORE_SFC
+  systems.append({"Super Famicom", "Super Famicom", "[Nintendo] Super Famicom", true, "Gamepad", ares::SuperFamicom::load});
+  #endif
+  #ifdef CORE_N64
+  systems.append({"Nintendo 64", "Nintendo 64", "[Nintendo] Nintendo 64", true, "Gamepad", ares::Nintendo64::load});
+  #endif
+  #ifdef CORE_GB
+  systems.append({"Game Boy", "Game Boy", "[Nintendo] Game Boy", false, "", ares::GameBoy::load});
+  systems.append({"Game Boy Color", "Game Boy Color", "[Nintendo] Game Boy Color", false, "", ares::GameBoy::load});
+  #endif
+  #ifdef CORE_GBA
+  systems.append({"Game Boy Advance", "Game Boy Advance", "[Nintendo] Game Boy Advance", false, "", ares::GameBoyAdvance::load});
+  #endif
+  #ifdef CORE_SG
+  systems.append({"SG-1000", "SG-1000", "[Sega] SG-1000", true, "Gamepad", ares::SG1000::load});
+  #endif
+  #ifdef CORE_MS
+  systems.append({"Master System", "Master System", "[Sega] Master System", true, "Gamepad", ares::MasterSystem::load});
+  systems.append({"Game Gear", "Game Gear", "[Sega] Game Gear", true, "", ares::MasterSystem::load});
+  #endif
+  #ifdef CORE_MD
+  systems.append({"Mega Drive", "Mega Drive", "[Sega] Mega Drive", true, "Control Pad", ares::MegaDrive::load});
+  #endif
+  #ifdef CORE_PCE
+  systems.append({"PC Engine", "PC Engine", "[NEC] PC Engine", true, "Gamepad", ares::PCEngine::load});
+  #endif
+  #ifdef CORE_PS1
+  systems.append({"PlayStation", "PlayStation", "[Sony] PlayStation", true, "Digital Gamepad", ares::PlayStation::load});
+  #endif
+  #ifdef CORE_NG
+  systems.append({"Neo Geo AES", "Neo Geo", "[SNK] Neo Geo AES", false, "Arcade Stick", ares::NeoGeo::load});
+  #endif
+  #ifdef CORE_NGP
+  systems.append({"Neo Geo Pocket", "Neo Geo Pocket", "[SNK] Neo Geo Pocket", false, "", ares::NeoGeoPocket::load});
+  systems.append({"Neo Geo Pocket Color", "Neo Geo Pocket Color", "[SNK] Neo Geo Pocket Color", false, "", ares::NeoGeoPocket::load});
+  #endif
+  #ifdef CORE_MSX
+  systems.append({"MSX", "MSX", "[Microsoft] MSX", true, "Gamepad", ares::MSX::load});
+  #endif
+  #ifdef CORE_SPEC
+  systems.append({"ZX Spectrum", "ZX Spectrum", "[Sinclair] ZX Spectrum", false, "", ares::ZXSpectrum::load});
+  #endif
+  #ifdef CORE_WS
+  systems.append({"WonderSwan", "WonderSwan", "[Bandai] WonderSwan", false, "", ares::WonderSwan::load});
+  systems.append({"WonderSwan Color", "WonderSwan Color", "[Bandai] WonderSwan Color", false, "", ares::WonderSwan::load});
+  #endif
+}
+
+//handles region selection when games support multiple regions
+auto Benchmark::region() -> string {
+  if(preferredRegion) return preferredRegion;
+  if(game && game->pak) {
+    if(auto regions = game->pak->attribute("region").split(",").strip()) {
+      if(regions.first()) return regions.first();
+    }
+  }
+  return "NTSC-U";
+}
+
+auto Benchmark::load(const System& entry, const string& location) -> bool {
+  game = mia::Medium::create(entry.medium);
+  if(!game || !game->load(location)) return print("error: unable to load ", location, "\n"), false;
+
+  system = mia::System::create(entry.name);
+  if(!system || !system->load(firmware)) return print("error: unable to load ", entry.name, " system (missing --firmware?)\n"), false;
+
+  #ifdef CORE_N64
+  if(entry.name == "Nintendo 64") {
+    #if defined(VULKAN)
+    ares::Nintendo64::option("Enable GPU acceleration", true);
+    #else
+    ares::Nintendo64::option("Enable GPU acceleration", false);
+    #endif
+  }
+  #endif
+
+  #ifdef CORE_SFC
+  //the PPU implementation is chosen by the host before the system is loaded
+  if(entry.name == "Super Famicom") {
+    ares::SuperFamicom::option("Pixel Accuracy", false);
+  }
+  #endif
+
+  string name = entry.identifier;
+  if(entry.regional) name.append(" (", region(), ")");
+  if(!entry.load(root, name)) return print("error: unable to create ", name, "\n"), false;
+
+  for(auto slot : array<string[5]>{"Cartridge Slot", "PlayStation/Disc Tray", "Mega CD/Disc Tray", "PC Engine CD/Disc Tray", "Tape Deck/Tray"}) {
+    if(auto port = root->find<ares::Node::Port>(slot)) {
+      port->allocate();
+      port->connect();
+    }
+  }
+
+  if(entry.controller) {
+    for(auto id : range(2)) {
+      if(auto port = root->find<ares::Node::Port>({"Controller Port ", 1 + id})) {
+        port->allocate(entry.controller);
+        port->connect();
+      }
+    }
+  }
+
+  if(auto port = root->find<ares::Node::Port>("Keyboard")) {
+    if(auto layouts = port->supported()) {
+      port->allocate(layouts.first());
+      port->connect();
+    }
+  }
+
+  root->power();
+  return true;
+}
+
+//script format: one event per line, "frame: port/input = value"; the value is held until changed.
+//eg: "120: Controller Port 1/Start = 1"
+auto Benchmark::script(const string& location) -> bool {
+  auto document = string::read(location);
+  if(!document) return false;
+  for(auto line : document.split("\n")) {
+    line.strip();
+    if(!line || line.beginsWith("#")) continue;
+    auto part = line.split(":", 1L).strip();
+    if(part.size() != 2) return print("error: invalid script line: ", line, "\n"), false;
+    auto assignment = part[1].split("=", 1L).strip();
+    if(assignment.size() != 2) return print("error: invalid script line: ", line, "\n"), false;
+    events.append({part[0].natural(), assignment[0], assignment[1].integer()});
+  }
+  events.sort([](auto& lhs, auto& rhs) { return lhs.frame < rhs.frame; });
+  return true;
+}
+
+auto Benchmark::attach(ares::Node::Object node) -> void {
+  if(auto stream = node->cast<ares::Node::Audio::Stream>()) {
+    stream->setResamplerFrequency(48000);
+  }
+}
+
+auto Benchmark::pak(ares::Node::Object node) -> shared_pointer<vfs::directory> {
+  if(node->cast<ares::Node::System>()) return system->pak;
+  if(node->name().endsWith("Cartridge")) return game->pak;
+  if(node->name().endsWith("Disc")) return game->pak;
+  if(node->name().endsWith("Disk")) return game->pak;
+  return {};
+}
+
+auto Benchmark::video(ares::Node::Video::Screen, const u32* data, u32 pitch, u32 width, u32 height) -> void {
+  vblanks++;
+}
+
+auto Benchmark::audio(ares::Node::Audio::Stream node) -> void {
+  f64 samples[8];
+  while(node->pending()) node->read(samples);
+}
+
+auto Benchmark::input(ares::Node::Input::Input node) -> void {
+  auto device = ares::Node::parent(node);
+  if(!device) return;
+  auto port = ares::Node::parent(device);
+  if(!port) return;
+
+  s64 value = 0;
+  if(auto state = inputs.find({port->name(), "/", node->name()})) value = state();
+  if(auto button = node->cast<ares::Node::Input::Button>()) button->setValue(value);
+  if(auto axis = node->cast<ares::Node::Input::Axis>()) axis->setValue(value);
+  if(auto trigger = node->cast<ares::Node::Input::Trigger>()) trigger->setValue(value);
+}
+
+auto Benchmark::main(Arguments arguments) -> void {
+  construct();
+
+  string system;
+  string frameCount = "3600";
+  string warmupCount = "0";
+  string rate;
+  string scriptLocation;
+  arguments.take("--system", system);
+  arguments.take("--frames", frameCount);
+  arguments.take("--warmup", warmupCount);
+  arguments.take("--firmware", firmware);
+  arguments.take("--region", preferredRegion);
+  arguments.take("--rate", rate);
+  arguments.take("--script", scriptLocation);
+
+  if(arguments.take("--help") || !arguments) {
+    print("Usage: ares-benchmark [OPTIONS]... game\n\n");
+    print("Options:\n");
+    print("  --system name     Specify the system name (default: detect from game)\n");
+    print("  --frames count    Number of frames to measure (default: 3600)\n");
+    print("  --warmup count    Number of frames to run before measuring (default: 0)\n");
+    print("  --firmware file   Firmware image, for systems that require one\n");
+    print("  --region name     Preferred region (NTSC-U, NTSC-J, PAL)\n");
+    print("  --rate hz         Nominal frame rate (default: 50 for PAL, 60 otherwise)\n");
+    print("  --script file     Input script; one \"frame: port/input = value\" event per line\n");
+    print("\n");
+    print("Available Systems:\n");
+    print("  ");
+    for(auto& entry : systems) print(entry.name, ", ");
+    print("\n");
+    return;
+  }
+
+  string location = arguments.take();
+  if(!system) system = mia::identify(location);
+  maybe<System&> entry;
+  for(auto& candidate : systems) {
+    if(candidate.name == system || candidate.medium == system) entry = candidate;
+  }
+  if(!entry) return print("error: unsupported system: ", system ? system : location, "\n");
+  if(scriptLocation && !script(scriptLocation)) return print("error: unable to read script ", scriptLocation, "\n");
+
+  if(!load(*entry, location)) return;
+
+  u64 frames = frameCount.natural();
+  u64 warmup = warmupCount.natural();
+  f64 nominal = rate ? rate.real() : region().beginsWith("PAL") ? 50.0 : 60.0;
+  if(!frames) return print("error: no frames to run\n");
+
+  vector<u64> times;
+  times.reserve(frames);
+  u64 vblanksStart = 0;
+  u64 switches = 0;
+  u64 dropped = 0;
+  u64 start = 0;
+  auto droppedFrames = [&]() -> u64 {
+    u64 count = 0;
+    for(auto& screen : root->find<ares::Node::Video::Screen>()) count += screen->dropped();
+    return count;
+  };
+  u32 event = 0;
+  for(u64 frame : range(warmup + frames)) {
+    while(event < events.size() && events[event].frame <= frame) {
+      inputs.insert(events[event].input, events[event].value);
+      event++;
+    }
+    if(frame == warmup) {
+      vblanksStart = vblanks;
+      dropped = droppedFrames();
+      start = chrono::nanosecond();
+    }
+    u64 frameStart = chrono::nanosecond();
+    root->run();
+    if(frame >= warmup) {
+      times.append(chrono::nanosecond() - frameStart);
+      switches += ares::contextSwitches();
+    }
+  }
+  u64 elapsed = chrono::nanosecond() - start;
+  dropped = droppedFrames() - dropped;
+  root->unload();
+
+  f64 seconds = elapsed / 1'000'000'000.0;
+  f64 emulated = (vblanks - vblanksStart) / nominal;
+  times.sort();
+  auto percentile = [&](u32 percent) -> f64 {
+    u64 index = min(times.size() - 1, times.size() * percent / 100);
+    return times[index] / 1'000'000.0;
+  };
+  auto fixed = [](f64 value) -> string {
+    return string{(s64)(value * 100.0 + 0.5) / 100.0};
+  };
+
+  print(entry->name, ": ", Location::file(location), "\n");
+  print("  frames:     ", frames, " (", vblanks - vblanksStart, " vblanks) in ", fixed(seconds), "s\n");
+  print("  speed:      ", fixed(frames / seconds), " frames/s, ", fixed(emulated / seconds), "x real-time (", fixed(nominal), "hz)\n");
+  print("  frame time: min ", fixed(times.first() / 1'000'000.0), "ms, p50 ", fixed(percentile(50)), "ms, ");
+  print("p90 ", fixed(percentile(90)), "ms, p99 ", fixed(percentile(99)), "ms, max ", fixed(times.last() / 1'000'000.0), "ms\n");
+  print("  switches:   ", fixed((f64)switches / frames), " context switches/frame\n");
+  print("  dropped:    ", dropped, " frames not presented\n");
+}
+
+auto nall::main(Arguments arguments) -> void {
+  ares::Memory::FixedAllocator::get();
+  mia::setHomeLocation([]() -> string { return {Path::userData(), "ares/Systems/"}; });
+  mia::setSaveLocation([]() -> string { return {Path::temporary(), "ares-benchmark/"}; });
+
+  static Benchmark benchmark;
+  ares::platform = &benchmark;
+  benchmark.main(arguments);
+  ares::platform = nullptr;
+}